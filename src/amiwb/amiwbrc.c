@@ -90,6 +90,12 @@ static void parse_line(char *line) {
     else if (strcmp(key, "render_mode") == 0) {
         g_config.render_mode = atoi(value);
     }
+    else if (strcmp(key, "swap_mode") == 0) {
+        g_config.swap_mode = atoi(value);
+    }
+    else if (strcmp(key, "composite_backend") == 0) {
+        g_config.composite_backend = atoi(value);
+    }
     // Menu addons
     else if (strcmp(key, "menu_addons") == 0) {
         set_string(g_config.menu_addons, value, sizeof(g_config.menu_addons));
@@ -24,6 +24,8 @@ typedef struct {
     // Rendering configuration
     int target_fps;      // Target framerate (default 120)
     int render_mode;     // 0=on-demand (default), 1=continuous
+    int swap_mode;       // 0=XRender copy (default), 1=Present (vblank-paced)
+    int composite_backend; // 0=XRender (default), 1=CPU blend via MIT-SHM
 
     // Menu addons configuration
     char menu_addons[NAME_SIZE];  // Comma-separated addon list: "clock,cpu,ram"
@@ -93,6 +93,7 @@ extern char *iconify_path;
 
 #define RESOURCE_DIR_SYSTEM "/usr/local/share/amiwb"  
 #define RESOURCE_DIR_USER ".config/amiwb"  
+#define ICON_CACHE_DIR_USER ".cache/amiwb/icons"  // Pre-rasterized icons (icon_diskcache.c)
 
 //#define SYSFONT "fonts/SourceCodePro-Semibold.otf"
 //#define SYSFONT "fonts/SourceCodePro-Regular.otf"
@@ -5,6 +5,7 @@
 #include "about_sysinfo.h"
 #include "dialog_internal.h"
 #include "../render/rnd_public.h"
+#include "../font_manager.h"
 #include "../intuition/itn_internal.h"
 #include "../../toolkit/toolkit_config.h"
 #include <stdio.h>
@@ -720,43 +721,43 @@ SystemInfo *about_sysinfo_gather(void) {
 
         // Build all lines exactly as they appear in rendering and measure each
         snprintf(line, sizeof(line), "  Desktop : AmiWB %s", info->amiwb_version);
-        XftTextExtentsUtf8(width_dpy, width_font, (FcChar8*)line, strlen(line), &extents);
+        font_manager_text_extents(width_font, line, &extents);
         if (extents.xOff > max_width) max_width = extents.xOff;
 
         snprintf(line, sizeof(line), "  Toolkit : libamiwb %s", info->toolkit_version);
-        XftTextExtentsUtf8(width_dpy, width_font, (FcChar8*)line, strlen(line), &extents);
+        font_manager_text_extents(width_font, line, &extents);
         if (extents.xOff > max_width) max_width = extents.xOff;
 
         snprintf(line, sizeof(line), "  Distro  : %s %s", info->os_name, info->os_version);
-        XftTextExtentsUtf8(width_dpy, width_font, (FcChar8*)line, strlen(line), &extents);
+        font_manager_text_extents(width_font, line, &extents);
         if (extents.xOff > max_width) max_width = extents.xOff;
 
         snprintf(line, sizeof(line), "  Kernel  : %s %s", info->kernel_name, info->kernel_version);
-        XftTextExtentsUtf8(width_dpy, width_font, (FcChar8*)line, strlen(line), &extents);
+        font_manager_text_extents(width_font, line, &extents);
         if (extents.xOff > max_width) max_width = extents.xOff;
 
         snprintf(line, sizeof(line), "  Memory  : %s", info->total_ram);
-        XftTextExtentsUtf8(width_dpy, width_font, (FcChar8*)line, strlen(line), &extents);
+        font_manager_text_extents(width_font, line, &extents);
         if (extents.xOff > max_width) max_width = extents.xOff;
 
         snprintf(line, sizeof(line), "  CPU     : %s %s", info->cpu_name, info->cpu_arch);
-        XftTextExtentsUtf8(width_dpy, width_font, (FcChar8*)line, strlen(line), &extents);
+        font_manager_text_extents(width_font, line, &extents);
         if (extents.xOff > max_width) max_width = extents.xOff;
 
         snprintf(line, sizeof(line), "  iGPU    : %s %s", info->igpu_name, info->igpu_ram);
-        XftTextExtentsUtf8(width_dpy, width_font, (FcChar8*)line, strlen(line), &extents);
+        font_manager_text_extents(width_font, line, &extents);
         if (extents.xOff > max_width) max_width = extents.xOff;
 
         snprintf(line, sizeof(line), "  dGPU    : %s %s", info->dgpu_name, info->dgpu_ram);
-        XftTextExtentsUtf8(width_dpy, width_font, (FcChar8*)line, strlen(line), &extents);
+        font_manager_text_extents(width_font, line, &extents);
         if (extents.xOff > max_width) max_width = extents.xOff;
 
         snprintf(line, sizeof(line), "  Xorg    : X11 %s", info->xorg_version);
-        XftTextExtentsUtf8(width_dpy, width_font, (FcChar8*)line, strlen(line), &extents);
+        font_manager_text_extents(width_font, line, &extents);
         if (extents.xOff > max_width) max_width = extents.xOff;
 
         snprintf(line, sizeof(line), "  Input   : %s", info->input_backend);
-        XftTextExtentsUtf8(width_dpy, width_font, (FcChar8*)line, strlen(line), &extents);
+        font_manager_text_extents(width_font, line, &extents);
         if (extents.xOff > max_width) max_width = extents.xOff;
 
         // Calculate optimal width: max_text_width + left_padding + right_padding + borders
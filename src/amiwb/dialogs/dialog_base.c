@@ -4,6 +4,7 @@
 
 #include "dialog_internal.h"
 #include "../render/rnd_public.h"
+#include "../font_manager.h"
 #include "../intuition/itn_internal.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -202,9 +203,7 @@ void dialog_base_render_text_content(Dialog *dialog, Picture dest,
     }
 
     // Draw centered title above input box
-    XRenderColor text_color = BLACK;
-    XftColor xft_text;
-    XftColorAllocValue(dpy, canvas->visual, canvas->colormap, &text_color, &xft_text);
+    XftColor *xft_text = render_xft_color(canvas->visual, canvas->colormap, &BLACK);
 
     if (dialog->dialog_type == DIALOG_DELETE_CONFIRM) {
         //int content_width = canvas->width - BORDER_WIDTH_LEFT - BORDER_WIDTH_RIGHT_CLIENT;
@@ -215,9 +214,9 @@ void dialog_base_render_text_content(Dialog *dialog, Picture dest,
         // Line 1: "Warning" centered
         const char *warning = "Warning";
         XGlyphInfo warning_ext;
-        XftTextExtentsUtf8(dpy, font, (FcChar8*)warning, strlen(warning), &warning_ext);
+        font_manager_text_extents(font, warning, &warning_ext);
         int warning_x = BORDER_WIDTH_LEFT + (content_width - warning_ext.xOff) / 2;
-        XftDrawStringUtf8(canvas->xft_draw, &xft_text, font, warning_x, line_y,
+        XftDrawStringUtf8(canvas->xft_draw, xft_text, font, warning_x, line_y,
                          (FcChar8*)warning, strlen(warning));
         line_y += 30;
         */
@@ -230,35 +229,35 @@ void dialog_base_render_text_content(Dialog *dialog, Picture dest,
         const char *line5 = "Terminus inbound..";
 
 
-        XftDrawStringUtf8(canvas->xft_draw, &xft_text, font, text_left_x, line_y,
+        XftDrawStringUtf8(canvas->xft_draw, xft_text, font, text_left_x, line_y,
                  (FcChar8*)line1, strlen(line1));
         line_y += 14;
 
-        XftDrawStringUtf8(canvas->xft_draw, &xft_text, font, text_left_x, line_y,
+        XftDrawStringUtf8(canvas->xft_draw, xft_text, font, text_left_x, line_y,
                          (FcChar8*)line2, strlen(line2));
         line_y += 14;
 
-        XftDrawStringUtf8(canvas->xft_draw, &xft_text, font, text_left_x, line_y,
+        XftDrawStringUtf8(canvas->xft_draw, xft_text, font, text_left_x, line_y,
                          (FcChar8*)line3, strlen(line3));
         line_y += 14;
 
-        XftDrawStringUtf8(canvas->xft_draw, &xft_text, font, text_left_x, line_y,
+        XftDrawStringUtf8(canvas->xft_draw, xft_text, font, text_left_x, line_y,
                          (FcChar8*)line4, strlen(line4));
         line_y += 14;
 
-        XftDrawStringUtf8(canvas->xft_draw, &xft_text, font, text_left_x, line_y,
+        XftDrawStringUtf8(canvas->xft_draw, xft_text, font, text_left_x, line_y,
                  (FcChar8*)line5, strlen(line5));
         line_y += 35;
 
         const char *line6 = "Is it really Ok to delete:";
-        XftDrawStringUtf8(canvas->xft_draw, &xft_text, font, text_left_x, line_y,
+        XftDrawStringUtf8(canvas->xft_draw, xft_text, font, text_left_x, line_y,
                          (FcChar8*)line6, strlen(line6));
         line_y += 14;
 
         // Line 5: The delete summary (stored in text_buffer) - left aligned
         // This contains formatted text like "3 files and 4 directories?"
         const char *msg = dialog->text_buffer;
-        XftDrawStringUtf8(canvas->xft_draw, &xft_text, font, text_left_x, line_y,
+        XftDrawStringUtf8(canvas->xft_draw, xft_text, font, text_left_x, line_y,
                          (FcChar8*)msg, strlen(msg));
 
     } else if (dialog->dialog_type == DIALOG_EXECUTE_COMMAND) {
@@ -266,17 +265,17 @@ void dialog_base_render_text_content(Dialog *dialog, Picture dest,
         const char *title_text = "Enter Command and its Arguments:";
 
         XGlyphInfo title_ext;
-        XftTextExtentsUtf8(dpy, font, (FcChar8*)title_text, strlen(title_text), &title_ext);
+        font_manager_text_extents(font, title_text, &title_ext);
         int content_width = canvas->width - BORDER_WIDTH_LEFT - BORDER_WIDTH_RIGHT_CLIENT;
         int title_x = BORDER_WIDTH_LEFT + (content_width - title_ext.xOff) / 2;
         int title_y = BORDER_HEIGHT_TOP + 20;
-        XftDrawStringUtf8(canvas->xft_draw, &xft_text, font, title_x, title_y,
+        XftDrawStringUtf8(canvas->xft_draw, xft_text, font, title_x, title_y,
                          (FcChar8*)title_text, strlen(title_text));
 
         // Draw "Command:" label to the left of input box (same row)
         int label_x = BORDER_WIDTH_LEFT + DIALOG_MARGIN;
         int label_y = input_y + (INPUT_HEIGHT + font->ascent) / 2 - 2;  // Move up 2 pixels
-        XftDrawStringUtf8(canvas->xft_draw, &xft_text, font, label_x, label_y,
+        XftDrawStringUtf8(canvas->xft_draw, xft_text, font, label_x, label_y,
                          (FcChar8*)"Command:", 8);
 
         // Update InputField position and size if needed
@@ -300,17 +299,17 @@ void dialog_base_render_text_content(Dialog *dialog, Picture dest,
         }
 
         XGlyphInfo title_ext;
-        XftTextExtentsUtf8(dpy, font, (FcChar8*)title_text, strlen(title_text), &title_ext);
+        font_manager_text_extents(font, title_text, &title_ext);
         int content_width = canvas->width - BORDER_WIDTH_LEFT - BORDER_WIDTH_RIGHT_CLIENT;
         int title_x = BORDER_WIDTH_LEFT + (content_width - title_ext.xOff) / 2;
         int title_y = BORDER_HEIGHT_TOP + 20;
-        XftDrawStringUtf8(canvas->xft_draw, &xft_text, font, title_x, title_y,
+        XftDrawStringUtf8(canvas->xft_draw, xft_text, font, title_x, title_y,
                          (FcChar8*)title_text, strlen(title_text));
 
         // Draw "New Name:" label to the left of input box (same row)
         int label_x = BORDER_WIDTH_LEFT + DIALOG_MARGIN;
         int label_y = input_y + (INPUT_HEIGHT + font->ascent) / 2 - 2;  // Move up 2 pixels
-        XftDrawStringUtf8(canvas->xft_draw, &xft_text, font, label_x, label_y,
+        XftDrawStringUtf8(canvas->xft_draw, xft_text, font, label_x, label_y,
                          (FcChar8*)"New Name:", 9);
 
         // Update InputField position and size if needed
@@ -325,7 +324,5 @@ void dialog_base_render_text_content(Dialog *dialog, Picture dest,
         }
     }
 
-    // Clean up
-    XftColorFree(dpy, canvas->visual, canvas->colormap, &xft_text);
     // No need to destroy - using cached XftDraw
 }
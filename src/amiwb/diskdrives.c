@@ -214,6 +214,7 @@ static void add_new_drive(const char *device, const char *mount_point, const cha
         } else {
             if (old_label) free(old_label);  // Only free after successful strdup
         }
+        icon_update_label_width(icon);
         icon->type = TYPE_DEVICE;
         drive->icon = icon;
         
@@ -286,6 +287,7 @@ static void add_ramdisk_drive(void) {
         } else {
             if (old_label) free(old_label);
         }
+        icon_update_label_width(icon);
 
         icon->type = TYPE_DEVICE;
         drive->icon = icon;
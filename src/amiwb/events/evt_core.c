@@ -29,6 +29,7 @@
 #include <time.h>
 #include <sys/timerfd.h>  // For timerfd_create (Phase 1)
 #include <errno.h>        // For error reporting
+#include <signal.h>       // SIGUSR1 metrics snapshot
 
 // ============================================================================
 // Event Loop State (Private - Encapsulated)
@@ -69,7 +70,26 @@ static void debug_canvas_resolved(Canvas *canvas, int tx, int ty, const char *co
 // Initialize event handling
 // Initialize event subsystem (reserved for future setup).
 static char g_log_path[1024] = {0};
+
+// SIGUSR1: log a metrics snapshot from the event loop (used by bench-compositor)
+static volatile sig_atomic_t g_metrics_requested = 0;
+
+static void metrics_signal_handler(int sig) {
+    (void)sig;
+    g_metrics_requested = 1;
+}
+
 void init_events(void) {
+    // No SA_RESTART: the signal must wake select() so the snapshot isn't
+    // delayed until the next X event
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = metrics_signal_handler;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGUSR1, &sa, NULL) != 0) {
+        log_error("[EVENTS] Failed to install SIGUSR1 handler: %s", strerror(errno));
+    }
+
     #if LOGGING_ENABLED
     // Expand LOG_FILE_PATH (support leading $HOME)
     const char *cfg = LOG_FILE_PATH;
@@ -83,6 +103,30 @@ void init_events(void) {
     #endif
 }
 
+// Motion compression: a 1000Hz mouse queues far more MotionNotify events than
+// we can draw, and drag/resize/scrollbar handlers issue X requests for each.
+// Replace the event with the newest of the directly following motions for the
+// same window. Stops at any other event so press/release ordering is kept, and
+// at a state change so handlers still see every button/modifier transition.
+// Returns the number of events dropped.
+static int coalesce_motion(Display *dpy, XEvent *event) {
+    int dropped = 0;
+    XEvent next;
+
+    // QueuedAlready: only look at what is already read - never blocks or flushes
+    while (XEventsQueued(dpy, QueuedAlready) > 0) {
+        XPeekEvent(dpy, &next);
+        if (next.type != MotionNotify ||
+            next.xmotion.window != event->xmotion.window ||
+            next.xmotion.state != event->xmotion.state) {
+            break;
+        }
+        XNextEvent(dpy, event);
+        dropped++;
+    }
+    return dropped;
+}
+
 // Main event loop
 // Central dispatcher that forwards X events to subsystems. We translate
 // coordinates and reroute presses so each canvas receives coherent input.
@@ -138,6 +182,12 @@ void handle_events(void) {
         struct timeval timeout = {1, 0};  // 1 second timeout for time/drive checks
         int ready = select(max_fd + 1, &read_fds, NULL, NULL, &timeout);
 
+        if (g_metrics_requested) {
+            g_metrics_requested = 0;
+            log_error("[METRICS] Performance snapshot requested (SIGUSR1)");
+            itn_render_log_metrics();
+        }
+
         if (ready < 0) {
             if (errno != EINTR) {
                 log_error("[EVENTS] select() failed: %s", strerror(errno));
@@ -172,6 +222,9 @@ void handle_events(void) {
                 // Check for damage events
                 if (event.type == itn_core_get_damage_event_base() + XDamageNotify) {
                     itn_composite_process_damage((XDamageNotifyEvent *)&event);
+                } else if (itn_present_handle_event(&event)) {
+                    // PresentCompleteNotify - paces the next frame
+                    continue;
                 } else {
                     // Compositor events now handled by itn modules
                 }
@@ -182,6 +235,12 @@ void handle_events(void) {
                     continue;
         }
 
+        // Input-to-frame latency starts at the first input after a frame
+        // that actually damages something (checked after the handler)
+        bool timed_input = (event.type == ButtonPress || event.type == ButtonRelease ||
+                            event.type == MotionNotify || event.type == KeyPress);
+        if (timed_input) itn_trace_input_begin();
+
         switch (event.type) {
             case ButtonPress:
                 handle_button_press(&event.xbutton);
@@ -238,7 +297,8 @@ void handle_events(void) {
                     safe_set_input_focus(dpy, map_event->window, RevertToParent, CurrentTime);
                     itn_focus_set_active(canvas);
 
-                    // Schedule frame to show it
+                    // Damage its area and schedule frame to show it
+                    DAMAGE_CANVAS(canvas);
                     itn_render_schedule_frame();
                 }
                 intuition_handle_map_notify(map_event);
@@ -247,10 +307,14 @@ void handle_events(void) {
             case UnmapNotify:
                 handle_unmap_notify(&event.xunmap);
                 break;
+            case ReparentNotify:
+                intuition_handle_reparent_notify(&event.xreparent);
+                break;
             case ConfigureRequest:
                 handle_configure_request(&event.xconfigurerequest);
                 break;
             case MotionNotify:
+                itn_render_record_motion(coalesce_motion(dpy, &event));
                 handle_motion_notify(&event.xmotion);
                 break;
             case PropertyNotify:
@@ -298,6 +362,7 @@ void handle_events(void) {
             default:
                 break;
                 }
+                if (timed_input) itn_trace_input_end();
 
                 // Note: compositor_flush_pending is no longer needed with Phase 1
                 // The frame scheduler handles all batching automatically
@@ -164,10 +164,11 @@ void handle_key_press(XKeyEvent *event) {
                 itn_focus_cycle_prev();
                 return;
             }
-            // Super+Shift+D: Performance metrics debug
+            // Super+Shift+D: Performance metrics debug + frame trace dump
             if (keysym == XK_d || keysym == XK_D) {
                 log_error("[METRICS] Performance snapshot requested");
                 itn_render_log_metrics();
+                itn_trace_dump(NULL);
                 return;
             }
         } else {
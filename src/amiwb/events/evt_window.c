@@ -111,7 +111,8 @@ void handle_unmap_notify(XUnmapEvent *event) {
                 }
             }
 
-            // Schedule frame to remove from display
+            // Damage where it was and schedule frame to remove from display
+            DAMAGE_CANVAS(canvas);
             itn_render_schedule_frame();
             return;
         }
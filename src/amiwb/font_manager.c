@@ -7,6 +7,7 @@
 #include "font_manager.h"
 #include "config.h"
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
@@ -16,6 +17,27 @@
 static XftFont *the_font = NULL;
 static Display *font_display = NULL;
 
+// Text extents cache - labels, menu items and titles are measured over and
+// over with the same strings. LRU keyed by (font, string), fixed pool.
+#define TEXT_CACHE_SIZE 1024        // Entries kept
+#define TEXT_CACHE_BUCKETS 2048     // Hash buckets (power of two)
+
+typedef struct TextCacheEntry {
+    XftFont *font;
+    char *text;                     // Owned copy (NULL = free entry)
+    unsigned hash;
+    XGlyphInfo extents;
+    struct TextCacheEntry *hash_next;
+    struct TextCacheEntry *lru_prev;    // Towards most recently used
+    struct TextCacheEntry *lru_next;    // Towards least recently used
+} TextCacheEntry;
+
+static TextCacheEntry text_cache[TEXT_CACHE_SIZE];
+static TextCacheEntry *text_buckets[TEXT_CACHE_BUCKETS];
+static TextCacheEntry *lru_head = NULL;     // Most recently used
+static TextCacheEntry *lru_tail = NULL;     // Eviction candidate
+static int text_cache_used = 0;
+
 // Get the font file path - checks user dir then system dir
 static char* get_font_path(void) {
     char *home = getenv("HOME");
@@ -36,6 +58,68 @@ static char* get_font_path(void) {
     return NULL;
 }
 
+// ============================================================================
+// Text Extents Cache
+// ============================================================================
+
+static unsigned text_hash(XftFont *font, const char *text) {
+    unsigned hash = 2166136261u ^ (unsigned)(uintptr_t)font;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    return hash;
+}
+
+static void lru_unlink(TextCacheEntry *e) {
+    if (e->lru_prev) e->lru_prev->lru_next = e->lru_next;
+    else lru_head = e->lru_next;
+    if (e->lru_next) e->lru_next->lru_prev = e->lru_prev;
+    else lru_tail = e->lru_prev;
+    e->lru_prev = e->lru_next = NULL;
+}
+
+static void lru_push_front(TextCacheEntry *e) {
+    e->lru_prev = NULL;
+    e->lru_next = lru_head;
+    if (lru_head) lru_head->lru_prev = e;
+    lru_head = e;
+    if (!lru_tail) lru_tail = e;
+}
+
+static void bucket_remove(TextCacheEntry *e) {
+    TextCacheEntry **link = &text_buckets[e->hash & (TEXT_CACHE_BUCKETS - 1)];
+    while (*link && *link != e) link = &(*link)->hash_next;
+    if (*link) *link = e->hash_next;
+    e->hash_next = NULL;
+}
+
+// Free entry from the pool, or the least recently used one
+static TextCacheEntry *text_cache_take(void) {
+    if (text_cache_used < TEXT_CACHE_SIZE) {
+        return &text_cache[text_cache_used++];
+    }
+    TextCacheEntry *e = lru_tail;
+    lru_unlink(e);
+    bucket_remove(e);
+    free(e->text);
+    e->text = NULL;
+    return e;
+}
+
+static void text_cache_clear(void) {
+    for (int i = 0; i < text_cache_used; i++) {
+        free(text_cache[i].text);
+    }
+    memset(text_cache, 0, sizeof(text_cache));
+    memset(text_buckets, 0, sizeof(text_buckets));
+    lru_head = lru_tail = NULL;
+    text_cache_used = 0;
+}
+
+// ============================================================================
+// Font Lifecycle
+// ============================================================================
+
 bool font_manager_init(Display *dpy) {
     if (the_font) {
         // Already initialized
@@ -92,6 +176,8 @@ XftFont* font_manager_get(void) {
 }
 
 void font_manager_cleanup(bool is_restarting) {
+    text_cache_clear();
+
     if (!the_font) {
         return;
     }
@@ -113,13 +199,47 @@ void font_manager_cleanup(bool is_restarting) {
     }
 }
 
+// XftTextExtentsUtf8 through the cache - same result, measured once
+void font_manager_text_extents(XftFont *font, const char *text, XGlyphInfo *extents) {
+    memset(extents, 0, sizeof(*extents));
+    if (!font || !text || !font_display) {
+        return;
+    }
+
+    unsigned hash = text_hash(font, text);
+    TextCacheEntry *e = text_buckets[hash & (TEXT_CACHE_BUCKETS - 1)];
+    for (; e; e = e->hash_next) {
+        if (e->hash == hash && e->font == font && strcmp(e->text, text) == 0) {
+            if (e != lru_head) {
+                lru_unlink(e);
+                lru_push_front(e);
+            }
+            *extents = e->extents;
+            return;
+        }
+    }
+
+    XftTextExtentsUtf8(font_display, font, (FcChar8*)text, strlen(text), extents);
+
+    char *copy = strdup(text);
+    if (!copy) return;  // Still measured, just not cached
+    e = text_cache_take();
+    e->font = font;
+    e->text = copy;
+    e->hash = hash;
+    e->extents = *extents;
+    e->hash_next = text_buckets[hash & (TEXT_CACHE_BUCKETS - 1)];
+    text_buckets[hash & (TEXT_CACHE_BUCKETS - 1)] = e;
+    lru_push_front(e);
+}
+
 int font_manager_text_width(const char *text) {
     if (!the_font || !text || !font_display) {
         return 0;
     }
 
     XGlyphInfo extents;
-    XftTextExtentsUtf8(font_display, the_font, (FcChar8*)text, strlen(text), &extents);
+    font_manager_text_extents(the_font, text, &extents);
     return extents.xOff;
 }
 
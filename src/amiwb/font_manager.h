@@ -25,6 +25,10 @@ void font_manager_cleanup(bool is_restarting);
 // Get text width using the global font
 int font_manager_text_width(const char *text);
 
+// XftTextExtentsUtf8 of a whole string, from an LRU cache keyed by
+// (font, string) - use this for anything measured on every redraw
+void font_manager_text_extents(XftFont *font, const char *text, XGlyphInfo *extents);
+
 // Get font metrics
 int font_manager_get_ascent(void);
 int font_manager_get_descent(void);
@@ -6,13 +6,61 @@
 #include <unistd.h>
 #include <Imlib2.h>
 
-// Load AICON format (PNG-based container with normal/selected states)
-// Uses Imlib2 for PNG decoding and rendering
-int icon_load_aicon(FileIcon *icon, RenderContext *ctx,
-                    const uint8_t *data, long size) {
+// Decode one embedded PNG into a raster
+// Imlib2 only loads from files, so the PNG goes through a temp file.
+// Imlib2 hands out straight alpha; XRender wants premultiplied, so color
+// is scaled by alpha while copying (opaque and clear pixels are unchanged).
+static bool png_to_raster(const uint8_t *png, uint32_t png_size,
+                          const char *tmp_path, IconRaster *out) {
+    FILE *tmp_file = fopen(tmp_path, "wb");
+    if (!tmp_file) {
+        log_error("[ERROR] Failed to create temp file for AICON");
+        return false;
+    }
+    fwrite(png, 1, png_size, tmp_file);
+    fclose(tmp_file);
+
+    Imlib_Image img = imlib_load_image(tmp_path);
+    unlink(tmp_path);  // Delete temp file
+    if (!img) return false;
+
+    imlib_context_set_image(img);
+    int width = imlib_image_get_width();
+    int height = imlib_image_get_height();
+    const uint32_t *src = imlib_image_get_data_for_reading_only();
+
+    bool ok = src && icon_raster_alloc(out, width, height);
+    if (ok) {
+        size_t count = (size_t)width * height;
+        for (size_t i = 0; i < count; i++) {
+            uint32_t px = src[i];
+            uint32_t a = px >> 24;
+            if (a == 0xFF) {
+                out->pixels[i] = px;
+            } else {
+                uint32_t r = ((px >> 16) & 0xFF) * a / 255;
+                uint32_t g = ((px >> 8) & 0xFF) * a / 255;
+                uint32_t b = (px & 0xFF) * a / 255;
+                out->pixels[i] = (a << 24) | (r << 16) | (g << 8) | b;
+            }
+        }
+    }
+
+    imlib_free_image();
+    return ok;
+}
+
+// Decode AICON format (PNG-based container with normal/selected states)
+// Uses Imlib2 for PNG decoding - main thread only, Imlib2 isn't thread safe
+// OWNERSHIP: On success caller frees dec with icon_decoded_free()
+// Returns 0 on success, -1 on failure
+int icon_decode_aicon(const uint8_t *data, long size, IconDecoded *dec,
+                      const char *icon_path) {
+    memset(dec, 0, sizeof(*dec));
+
     // Verify header size
     if (size < sizeof(AiconHeader)) {
-        log_error("[ERROR] AICON file too small: %s", icon->path);
+        log_error("[ERROR] AICON file too small: %s", icon_path);
         return -1;
     }
 
@@ -20,13 +68,13 @@ int icon_load_aicon(FileIcon *icon, RenderContext *ctx,
 
     // Verify magic
     if (memcmp(hdr->magic, "AICON", 5) != 0) {
-        log_error("[ERROR] Invalid AICON magic in %s", icon->path);
+        log_error("[ERROR] Invalid AICON magic in %s", icon_path);
         return -1;
     }
 
     // Check version
     if (hdr->version != AICON_VERSION) {
-        log_error("[ERROR] Unsupported AICON version %d in %s", hdr->version, icon->path);
+        log_error("[ERROR] Unsupported AICON version %d in %s", hdr->version, icon_path);
         return -1;
     }
 
@@ -44,7 +92,7 @@ int icon_load_aicon(FileIcon *icon, RenderContext *ctx,
 
         // Validate offset and size
         if (offset + sec_size > size) {
-            log_error("[ERROR] Invalid AICON section offset in %s", icon->path);
+            log_error("[ERROR] Invalid AICON section offset in %s", icon_path);
             return -1;
         }
 
@@ -67,101 +115,26 @@ int icon_load_aicon(FileIcon *icon, RenderContext *ctx,
 
     // Must have at least normal PNG
     if (!png1_data || png1_size == 0) {
-        log_error("[ERROR] AICON missing normal PNG in %s", icon->path);
+        log_error("[ERROR] AICON missing normal PNG in %s", icon_path);
         return -1;
     }
 
-    // Load PNG using Imlib2 (via temporary file, as Imlib2 doesn't support memory loading)
     char tmp_path[256];
     snprintf(tmp_path, sizeof(tmp_path), "/tmp/amiwb_aicon_%d.png", getpid());
 
-    FILE *tmp_file = fopen(tmp_path, "wb");
-    if (!tmp_file) {
-        log_error("[ERROR] Failed to create temp file for AICON");
-        return -1;
-    }
-    fwrite(png1_data, 1, png1_size, tmp_file);
-    fclose(tmp_file);
-
-    // Load with Imlib2
-    Imlib_Image img1 = imlib_load_image(tmp_path);
-    unlink(tmp_path);  // Delete temp file
-
-    if (!img1) {
-        log_error("[ERROR] Failed to decode PNG in AICON %s", icon->path);
-        return -1;
-    }
-
-    // Get dimensions
-    imlib_context_set_image(img1);
-    int width = imlib_image_get_width();
-    int height = imlib_image_get_height();
-
-    // Get 32-bit TrueColor visual for alpha compositing (same as classic icons)
-    XVisualInfo vinfo;
-    Pixmap normal_pixmap;
-    XImage *unused_image;
-    if (icon_create_rendering_context(ctx->dpy, width, height, &normal_pixmap, &unused_image, &vinfo) != 0) {
-        imlib_free_image();
+    if (!png_to_raster(png1_data, png1_size, tmp_path, &dec->normal)) {
+        log_error("[ERROR] Failed to decode PNG in AICON %s", icon_path);
         return -1;
     }
-    XDestroyImage(unused_image);  // Imlib2 renders directly to pixmap, don't need XImage
-
-    // Configure Imlib2 context
-    imlib_context_set_display(ctx->dpy);
-    imlib_context_set_visual(vinfo.visual);
-    imlib_context_set_colormap(DefaultColormap(ctx->dpy, DefaultScreen(ctx->dpy)));
-    imlib_context_set_drawable(normal_pixmap);
-    imlib_context_set_image(img1);
-
-    // Render to pixmap
-    imlib_render_image_on_drawable(0, 0);
-
-    // Create Picture for compositing
-    icon->normal_picture = icon_create_picture(ctx->dpy, normal_pixmap, ctx->fmt);
-    icon->width = width;
-    icon->height = height;
-
-    imlib_free_image();
-
-    // Load selected state (if provided)
-    Pixmap selected_pixmap = None;
-
-    if (png2_data && png2_size > 0) {
-        // Load second PNG
-        tmp_file = fopen(tmp_path, "wb");
-        if (tmp_file) {
-            fwrite(png2_data, 1, png2_size, tmp_file);
-            fclose(tmp_file);
-
-            Imlib_Image img2 = imlib_load_image(tmp_path);
-            unlink(tmp_path);
-
-            if (img2) {
-                imlib_context_set_image(img2);
-
-                selected_pixmap = XCreatePixmap(ctx->dpy, DefaultRootWindow(ctx->dpy),
-                                               width, height, ICON_RENDER_DEPTH);
-                if (selected_pixmap) {
-                    imlib_context_set_drawable(selected_pixmap);
-                    imlib_render_image_on_drawable(0, 0);
-                }
-
-                imlib_free_image();
-            }
-        }
-    }
 
-    // If no selected PNG provided, create darkened version
-    if (selected_pixmap == None) {
-        selected_pixmap = icon_create_darkened_pixmap(ctx->dpy, normal_pixmap, width, height);
+    // Selected state if provided, else the normal image darkened at upload
+    if (png2_data && png2_size > 0 &&
+        png_to_raster(png2_data, png2_size, tmp_path, &dec->selected)) {
+        dec->sel_kind = ICON_SELECTED_OWN;
+    } else {
+        dec->sel_kind = ICON_SELECTED_SHADED;
     }
 
-    icon->selected_picture = icon_create_picture(ctx->dpy, selected_pixmap, ctx->fmt);
-    icon->sel_width = width;
-    icon->sel_height = height;
-    icon->current_picture = icon->normal_picture;
-
-    // Successfully loaded AICON
+    // Successfully decoded AICON
     return 0;
 }
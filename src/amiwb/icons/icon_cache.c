@@ -0,0 +1,140 @@
+// File: icon_cache.c
+// Shared decoded icon images - one set of Pictures per .info file
+// Thousands of files in a drawer usually show the same few deficons
+// (def_foo.info, def_dir.info). Icons decoded from the same file (same
+// path, mtime and size) share one refcounted normal/selected Picture pair;
+// destroy_file_icon() drops the reference, the last one frees the Pictures.
+// An edited .info gets a new mtime and is decoded again - the stale entry
+// lives on until the icons still showing it are gone.
+#include "icon_internal.h"
+#include "../intuition/itn_public.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Module-Private State
+// ============================================================================
+
+#define ICON_CACHE_BUCKETS 1024
+
+struct IconImage {
+    char *path;                 // .info file actually decoded
+    time_t mtime;
+    off_t size;
+    Picture normal_picture;
+    Picture selected_picture;   // May be normal_picture (no selected image)
+    int width, height;
+    int sel_width, sel_height;
+    int refs;                   // FileIcons using these Pictures
+    struct IconImage *next;     // Bucket chain
+};
+
+static IconImage *g_buckets[ICON_CACHE_BUCKETS];
+
+// ============================================================================
+// Internal Implementation
+// ============================================================================
+
+static unsigned path_bucket(const char *path) {
+    unsigned h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)path; *p; p++) {
+        h = (h ^ *p) * 16777619u;
+    }
+    return h % ICON_CACHE_BUCKETS;
+}
+
+static void apply_image(FileIcon *icon, IconImage *img) {
+    icon->image = img;
+    icon->normal_picture = img->normal_picture;
+    icon->selected_picture = img->selected_picture;
+    icon->current_picture = img->normal_picture;
+    icon->width = img->width;
+    icon->height = img->height;
+    icon->sel_width = img->sel_width;
+    icon->sel_height = img->sel_height;
+}
+
+static void unlink_image(IconImage *img) {
+    IconImage **link = &g_buckets[path_bucket(img->path)];
+    while (*link && *link != img) link = &(*link)->next;
+    if (*link) *link = img->next;
+}
+
+// ============================================================================
+// Public API (internal to icons module)
+// ============================================================================
+
+// Share an already decoded image of icon_path with this icon
+// Returns false on a miss - caller decodes and calls icon_cache_insert()
+bool icon_cache_acquire(FileIcon *icon, const char *icon_path, const struct stat *st) {
+    if (!icon || !icon_path || !st) return false;
+
+    for (IconImage *img = g_buckets[path_bucket(icon_path)]; img; img = img->next) {
+        if (img->mtime == st->st_mtime && img->size == st->st_size &&
+            strcmp(img->path, icon_path) == 0) {
+            img->refs++;
+            apply_image(icon, img);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Any image of icon_path in memory? (drawer prefetch skips those)
+// Path only - a stale entry just means the icon decodes on the main thread
+bool icon_cache_has_path(const char *icon_path) {
+    if (!icon_path) return false;
+    for (IconImage *img = g_buckets[path_bucket(icon_path)]; img; img = img->next) {
+        if (strcmp(img->path, icon_path) == 0) return true;
+    }
+    return false;
+}
+
+// Hand the Pictures just decoded into icon over to the cache (icon keeps
+// the first reference). Nothing decoded, or out of memory: icon keeps
+// owning its Pictures and icon_free_pictures() frees them directly.
+void icon_cache_insert(FileIcon *icon, const char *icon_path, const struct stat *st) {
+    if (!icon || !icon_path || !st || icon->normal_picture == None) return;
+
+    IconImage *img = calloc(1, sizeof(IconImage));
+    if (!img) return;
+    img->path = strdup(icon_path);
+    if (!img->path) {
+        free(img);
+        return;
+    }
+    img->mtime = st->st_mtime;
+    img->size = st->st_size;
+    img->normal_picture = icon->normal_picture;
+    img->selected_picture = icon->selected_picture;
+    img->width = icon->width;
+    img->height = icon->height;
+    img->sel_width = icon->sel_width;
+    img->sel_height = icon->sel_height;
+    img->refs = 1;
+
+    unsigned b = path_bucket(icon_path);
+    img->next = g_buckets[b];
+    g_buckets[b] = img;
+    icon->image = img;
+}
+
+// Drop the icon's reference - the last one frees the shared Pictures
+void icon_cache_release(FileIcon *icon) {
+    if (!icon || !icon->image) return;
+    IconImage *img = icon->image;
+    icon->image = NULL;
+
+    if (--img->refs > 0) return;
+
+    Display *dpy = itn_core_get_display();
+    if (dpy) {
+        if (img->selected_picture && img->selected_picture != img->normal_picture) {
+            XRenderFreePicture(dpy, img->selected_picture);
+        }
+        if (img->normal_picture) XRenderFreePicture(dpy, img->normal_picture);
+    }
+    unlink_image(img);
+    free(img->path);
+    free(img);
+}
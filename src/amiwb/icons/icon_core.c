@@ -2,6 +2,7 @@
 // Public API implementation for icon lifecycle management
 #include "icon_internal.h"
 #include "../intuition/itn_public.h"
+#include "../font_manager.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -14,46 +15,32 @@ static char *def_drawer_path = "/usr/local/share/amiwb/icons/def_icons/def_dir.i
 // OWNERSHIP: Frees Pictures only - does NOT free icon struct or paths
 void icon_free_pictures(FileIcon* icon) {
     if (!icon) return;
-    Display *dpy = itn_core_get_display();
-    if (!dpy) return;
-    if (icon->normal_picture) XRenderFreePicture(dpy, icon->normal_picture);
-    if (icon->selected_picture) XRenderFreePicture(dpy, icon->selected_picture);
+    if (icon->image) {
+        // Shared with other icons of the same .info - drop our reference
+        icon_cache_release(icon);
+    } else {
+        Display *dpy = itn_core_get_display();
+        if (!dpy) return;
+        if (icon->selected_picture && icon->selected_picture != icon->normal_picture) {
+            XRenderFreePicture(dpy, icon->selected_picture);
+        }
+        if (icon->normal_picture) XRenderFreePicture(dpy, icon->normal_picture);
+    }
     icon->normal_picture = None;
     icon->selected_picture = None;
     icon->current_picture = None;
 }
 
-// Load icon images from .info file and create Pictures
-// This is the main rendering function that ties all format handlers together
-void create_icon_images(FileIcon *icon, RenderContext *ctx) {
-    if (!icon || !ctx) return;
-
-    const char *icon_path = icon->path;
-    if (!strstr(icon_path, ".info")) {
-        icon_path = (icon->type == TYPE_DRAWER || icon->type == TYPE_ICONIFIED) ?
-                    def_drawer_path : def_tool_path;
-    }
-
-    uint8_t *data;
-    long size;
-
-    if (icon_load_file(icon_path, &data, &size)) {
-        log_error("[ERROR] icon_core.c:create_icon_images() - Failed to load icon file: %s", icon_path);
-        return;
-    }
-
-    // Check for AICON format (PNG container)
-    if (size >= 5 && memcmp(data, "AICON", 5) == 0) {
-        icon_load_aicon(icon, ctx, data, size);
-        free(data);
-        return;
-    }
-
+// Decode the contents of a classic/GlowIcon .info into CPU rasters
+// This is the main decoding function that ties all format handlers together
+// Takes ownership of data. No X calls - runs on decoder threads too.
+static IconDecodeResult decode_icon_data(const char *icon_path, uint8_t *data, long size,
+                                         IconDecoded *dec) {
     // Check for Amiga format (classic DiskObject)
     if (size < 78 || icon_read_be16(data) != 0xE310 || icon_read_be16(data + 2) != 1) {
         log_error("[ERROR] icon_core.c:create_icon_images() - Invalid icon header in %s", icon_path);
         free(data);
-        return;
+        return ICON_DECODE_FAILED;
     }
 
 
@@ -68,11 +55,10 @@ void create_icon_images(FileIcon *icon, RenderContext *ctx) {
 
     if (header_offset + ICON_HEADER_SIZE > size) {
         free(data);
-        return;
+        return ICON_DECODE_FAILED;
     }
 
     uint16_t width, height, depth;
-    Pixmap normal_pixmap = None;
 
     // Read the icon header values - but first check depth to see if header is valid
     depth = icon_read_be16(data + header_offset + 8);
@@ -106,9 +92,7 @@ void create_icon_images(FileIcon *icon, RenderContext *ctx) {
                 long fallback_size;
                 if (icon_load_file(def_tool_path, &fallback_data, &fallback_size)) {
                     // def_foo should always exist as part of installation
-                    icon->normal_picture = None;
-                    icon->selected_picture = None;
-                    return;
+                    return ICON_DECODE_FAILED;
                 }
 
                 // Use the fallback data instead
@@ -118,7 +102,7 @@ void create_icon_images(FileIcon *icon, RenderContext *ctx) {
                 // Re-parse the header with def_foo data
                 if (size < 78 || icon_read_be16(data) != 0xE310 || icon_read_be16(data + 2) != 1) {
                     free(data);
-                    return;
+                    return ICON_DECODE_FAILED;
                 }
 
                 // Re-detect format and re-calculate offsets for def_foo
@@ -133,9 +117,7 @@ void create_icon_images(FileIcon *icon, RenderContext *ctx) {
                 if (depth == 0xFFFF || depth == 0 || depth > 8) {
                     // def_foo should be valid!
                     free(data);
-                    icon->normal_picture = None;
-                    icon->selected_picture = None;
-                    return;
+                    return ICON_DECODE_FAILED;
                 }
                 width = icon_read_be16(data + header_offset + 4);
                 height = icon_read_be16(data + header_offset + 6);
@@ -146,80 +128,51 @@ void create_icon_images(FileIcon *icon, RenderContext *ctx) {
 
     // Now render the classic icon (either the original or def_foo fallback)
     // Skip rendering if we have invalid classic but will use GlowIcon instead
-    normal_pixmap = None;
     if (!has_invalid_classic) {
         // Calculate how much data is available after the header
         long first_image_data_size = size - (header_offset + ICON_HEADER_SIZE);
         if (first_image_data_size < 0) first_image_data_size = 0;
 
-        if (icon_render(ctx->dpy, &normal_pixmap, data + header_offset + ICON_HEADER_SIZE, width, height, depth, format, first_image_data_size)) {
+        if (icon_render(&dec->normal, data + header_offset + ICON_HEADER_SIZE, width, height, depth, format, first_image_data_size)) {
             free(data);
-            return;
+            return ICON_DECODE_FAILED;
         }
-        icon->normal_picture = XRenderCreatePicture(ctx->dpy, normal_pixmap, ctx->fmt, 0, NULL);
     }
 
     uint32_t has_selected = icon_read_be32(data + 0x1A);
-    if (!has_invalid_classic && has_selected && icon->normal_picture) {
+    if (!has_invalid_classic && has_selected && dec->normal.pixels) {
         int row_bytes;
         long plane_size, first_data_size;
         icon_calculate_plane_dimensions(width, height, depth, &row_bytes, &plane_size, &first_data_size);
         int second_header_offset = header_offset + ICON_HEADER_SIZE + first_data_size;
         if (second_header_offset + ICON_HEADER_SIZE > size) {
-            icon_cleanup_partial(ctx->dpy, icon);
+            icon_decoded_free(dec);
             free(data);
-            return;
+            return ICON_DECODE_FAILED;
         }
 
         uint16_t sel_width, sel_height, sel_depth;
         if (icon_parse_header(data + second_header_offset, size - second_header_offset, &sel_width, &sel_height, &sel_depth)) {
-            icon_cleanup_partial(ctx->dpy, icon);
+            icon_decoded_free(dec);
             free(data);
-            return;
+            return ICON_DECODE_FAILED;
         }
 
         // Allow different sized selected images
-        Pixmap selected_pixmap;
         // Calculate how much data is available for second image
         long second_image_data_size = size - (second_header_offset + ICON_HEADER_SIZE);
         if (second_image_data_size < 0) second_image_data_size = 0;
 
-        if (icon_render(ctx->dpy, &selected_pixmap, data + second_header_offset + ICON_HEADER_SIZE, sel_width, sel_height, sel_depth, format, second_image_data_size)) {
-            icon_cleanup_partial(ctx->dpy, icon);
+        if (icon_render(&dec->selected, data + second_header_offset + ICON_HEADER_SIZE, sel_width, sel_height, sel_depth, format, second_image_data_size)) {
+            icon_decoded_free(dec);
             free(data);
-            return;
+            return ICON_DECODE_FAILED;
         }
-        icon->selected_picture = icon_create_picture(ctx->dpy, selected_pixmap, ctx->fmt);
-        icon->sel_width = sel_width;
-        icon->sel_height = sel_height;
-    } else if (!has_invalid_classic && icon->normal_picture && normal_pixmap != None && form_offset < 0) {
-        // No selected image - create darkened version like AmigaOS
+        dec->sel_kind = ICON_SELECTED_OWN;
+    } else if (!has_invalid_classic && dec->normal.pixels && form_offset < 0) {
+        // No selected image - darkened version like AmigaOS (shaded at upload)
         // But skip if GlowIcon will be parsed later (form_offset >= 0)
-        Pixmap dark_pixmap = icon_create_darkened_pixmap(ctx->dpy, normal_pixmap, width, height);
-        if (dark_pixmap) {
-            // Ownership transfer: icon_create_picture() takes and frees dark_pixmap
-            icon->selected_picture = icon_create_picture(ctx->dpy, dark_pixmap, ctx->fmt);
-        } else {
-            // Fallback to same image if darkening fails
-            icon->selected_picture = icon->normal_picture;
-        }
-        icon->sel_width = width;
-        icon->sel_height = height;
-    }
-
-    if (normal_pixmap != None) {
-        XFreePixmap(ctx->dpy, normal_pixmap);
-        normal_pixmap = None;  // Prevent use-after-free
-    }
-
-    // Only set dimensions if they're valid
-    if (width > 0 && width <= 256 && height > 0 && height <= 256) {
-        icon->width = width;
-        icon->height = height;
-    } else {
-        // Will get dimensions from GlowIcon if present
-        icon->width = 0;
-        icon->height = 0;
+        dec->sel_kind = ICON_SELECTED_SHADED;
     }
 
     // Check for ColorIcon/GlowIcon after the classic icon data
@@ -310,69 +263,31 @@ void create_icon_images(FileIcon *icon, RenderContext *ctx) {
     if (form_offset >= 0 && form_offset + 4 <= size) {
         // GlowIcon detected - parse it silently unless there's an error
 
-        Pixmap color_normal = 0, color_selected = 0;
-        uint16_t color_width = 0, color_height = 0;
-        uint16_t color_sel_width = 0, color_sel_height = 0;
-
-        int parse_result = icon_parse_glowicon(ctx->dpy, data, size, form_offset,
-                               &color_normal, &color_selected,
-                               &color_width, &color_height,
-                               &color_sel_width, &color_sel_height,
-                               ctx->fmt, icon_path);
-
+        IconRaster color_normal = {0}, color_selected = {0};
 
-            if (parse_result == 0) {
+        int parse_result = icon_parse_glowicon(data, size, form_offset,
+                               &color_normal, &color_selected, icon_path);
 
+        if (parse_result == 0 && color_normal.pixels) {
             // Use ColorIcon instead of classic icon
-            if (color_normal) {
-                // Free classic icon Pictures
-                if (icon->normal_picture) {
-                    XRenderFreePicture(ctx->dpy, icon->normal_picture);
-                }
-                if (icon->selected_picture && icon->selected_picture != icon->normal_picture) {
-                    XRenderFreePicture(ctx->dpy, icon->selected_picture);
-                }
-
-                // Use ColorIcon
-                icon->normal_picture = XRenderCreatePicture(ctx->dpy, color_normal, ctx->fmt, 0, NULL);
-                icon->width = color_width;
-                icon->height = color_height;
-
-                if (color_selected) {
-                    icon->selected_picture = XRenderCreatePicture(ctx->dpy, color_selected, ctx->fmt, 0, NULL);
-                    icon->sel_width = color_sel_width;
-                    icon->sel_height = color_sel_height;
-                    XFreePixmap(ctx->dpy, color_selected);
-                } else {
-                    // No selected image - create darkened version
-                    Pixmap dark_pixmap = icon_create_darkened_pixmap(ctx->dpy, color_normal, color_width, color_height);
-                    if (dark_pixmap) {
-                        // Ownership transfer: icon_create_picture() takes and frees dark_pixmap
-                        icon->selected_picture = icon_create_picture(ctx->dpy, dark_pixmap, ctx->fmt);
-                    } else {
-                        // Fallback to same image if darkening fails
-                        icon->selected_picture = icon->normal_picture;
-                    }
-                    icon->sel_width = color_width;
-                    icon->sel_height = color_height;
-                }
-
-                XFreePixmap(ctx->dpy, color_normal);
-
-                // Set current_picture for GlowIcon
-                icon->current_picture = icon->normal_picture;
+            icon_decoded_free(dec);
+            dec->normal = color_normal;
+            if (color_selected.pixels) {
+                dec->selected = color_selected;
+                dec->sel_kind = ICON_SELECTED_OWN;
+            } else {
+                // No selected image - darkened version
+                dec->sel_kind = ICON_SELECTED_SHADED;
             }
+        } else {
+            icon_raster_free(&color_normal);
+            icon_raster_free(&color_selected);
         }
     }
 
-    // Set current_picture if not already set (classic icon case)
-    if (!icon->current_picture) {
-        icon->current_picture = icon->normal_picture;
-    }
-
     // Handle special case: OS3 icons with depth=0xFFFF but valid bitmap data
     // These icons have no FORM chunk but do have bitmap data at fixed offset
-    if (!icon->normal_picture && !icon->current_picture) {
+    if (!dec->normal.pixels) {
 
         // Check if this might be an old-style icon with non-standard header
         uint32_t user_data = icon_read_be32(data + 0x2C);  // userData field at offset 0x2C indicates OS version
@@ -446,24 +361,20 @@ void create_icon_images(FileIcon *icon, RenderContext *ctx) {
                     bitmap_start = data + 0x62;  // 0x4E + 20 (Image structure size)
                 }
 
-                Pixmap icon_pixmap = None;
                 int render_result = 1;
 
                 if (user_data == 0) {
                     // OS1.3 icon - use special renderer with transparent background
-                    render_result = icon_render_os13(ctx->dpy, &icon_pixmap, bitmap_start, img_width, img_height);
+                    render_result = icon_render_os13(&dec->normal, bitmap_start, img_width, img_height);
                     } else {
                         // OS3 icon - use standard renderer
                         // Calculate available data size for this image
                         long available_data = size - (bitmap_start - data);
                         if (available_data < 0) available_data = 0;
-                        render_result = icon_render(ctx->dpy, &icon_pixmap, bitmap_start, img_width, img_height, img_depth, format, available_data);
+                        render_result = icon_render(&dec->normal, bitmap_start, img_width, img_height, img_depth, format, available_data);
                     }
 
                     if (!render_result) {
-                        icon->normal_picture = XRenderCreatePicture(ctx->dpy, icon_pixmap, ctx->fmt, 0, NULL);
-                        icon->width = img_width;
-                        icon->height = img_height;
 
                         // Check for selected image
                         uint32_t has_sel = icon_read_be32(data + 0x1A);
@@ -500,30 +411,18 @@ void create_icon_images(FileIcon *icon, RenderContext *ctx) {
                                         const uint8_t *sel_bitmap = data + selected_offset + 20;
 
 
-                                        Pixmap sel_pixmap = None;
-                                        int sel_result = icon_render_os13(ctx->dpy, &sel_pixmap, sel_bitmap,
-                                                                         sel_width, sel_height);
-                                        if (!sel_result) {
-                                            icon->selected_picture = XRenderCreatePicture(ctx->dpy, sel_pixmap,
-                                                                                         ctx->fmt, 0, NULL);
-                                            icon->sel_width = sel_width;
-                                            icon->sel_height = sel_height;
-                                            XFreePixmap(ctx->dpy, sel_pixmap);
+                                        if (!icon_render_os13(&dec->selected, sel_bitmap,
+                                                              sel_width, sel_height)) {
+                                            dec->sel_kind = ICON_SELECTED_OWN;
                                         }
                                     } else {
                                         // Not an Image structure, try as raw bitmap with same dimensions
                                         const uint8_t *sel_bitmap = data + selected_offset;
 
 
-                                        Pixmap sel_pixmap = None;
-                                        int sel_result = icon_render_os13(ctx->dpy, &sel_pixmap, sel_bitmap,
-                                                                         img_width, img_height);
-                                        if (!sel_result) {
-                                            icon->selected_picture = XRenderCreatePicture(ctx->dpy, sel_pixmap,
-                                                                                         ctx->fmt, 0, NULL);
-                                            icon->sel_width = img_width;
-                                            icon->sel_height = img_height;
-                                            XFreePixmap(ctx->dpy, sel_pixmap);
+                                        if (!icon_render_os13(&dec->selected, sel_bitmap,
+                                                              img_width, img_height)) {
+                                            dec->sel_kind = ICON_SELECTED_OWN;
                                         }
                                     }
                                 }
@@ -556,14 +455,8 @@ void create_icon_images(FileIcon *icon, RenderContext *ctx) {
 
                                     if (has_valid_data) {
 
-                                        Pixmap sel_pixmap = None;
-                                        int sel_result = icon_render_os13(ctx->dpy, &sel_pixmap, sel_bitmap, img_width, img_height);
-
-                                        if (!sel_result) {
-                                            icon->selected_picture = XRenderCreatePicture(ctx->dpy, sel_pixmap, ctx->fmt, 0, NULL);
-                                            icon->sel_width = img_width;
-                                            icon->sel_height = img_height;
-                                            XFreePixmap(ctx->dpy, sel_pixmap);
+                                        if (!icon_render_os13(&dec->selected, sel_bitmap, img_width, img_height)) {
+                                            dec->sel_kind = ICON_SELECTED_OWN;
                                         }
                                     }
                                 }
@@ -583,31 +476,20 @@ void create_icon_images(FileIcon *icon, RenderContext *ctx) {
                                         sel_has_data != 0) {
 
                                         const uint8_t *sel_bitmap = data + second_img_offset + 20;
-                                        Pixmap sel_pixmap = None;
                                         // Calculate available data for selected image
                                         long sel_data_size = size - (second_img_offset + 20);
                                         if (sel_data_size < 0) sel_data_size = 0;
-                                        int sel_result = icon_render(ctx->dpy, &sel_pixmap, sel_bitmap, sel_width, sel_height, sel_depth, format, sel_data_size);
-
-                                        if (!sel_result) {
-                                            icon->selected_picture = XRenderCreatePicture(ctx->dpy, sel_pixmap, ctx->fmt, 0, NULL);
-                                            icon->sel_width = sel_width;
-                                            icon->sel_height = sel_height;
-                                            XFreePixmap(ctx->dpy, sel_pixmap);
+                                        if (!icon_render(&dec->selected, sel_bitmap, sel_width, sel_height, sel_depth, format, sel_data_size)) {
+                                            dec->sel_kind = ICON_SELECTED_OWN;
                                         }
                                     }
                                 }
                             }
                         }
 
-                        if (!icon->selected_picture) {
-                            icon->selected_picture = icon->normal_picture;
-                            icon->sel_width = img_width;
-                            icon->sel_height = img_height;
+                        if (dec->sel_kind == ICON_SELECTED_NONE) {
+                            dec->sel_kind = ICON_SELECTED_NORMAL;
                         }
-
-                        icon->current_picture = icon->normal_picture;
-                        XFreePixmap(ctx->dpy, icon_pixmap);
                     }
                 }
             }
@@ -615,6 +497,102 @@ void create_icon_images(FileIcon *icon, RenderContext *ctx) {
 
 
     free(data);
+    return dec->normal.pixels ? ICON_DECODE_OK : ICON_DECODE_FAILED;
+}
+
+// ============================================================================
+// Decoding Pipeline (any thread)
+// ============================================================================
+
+// Read icon_path and decode it into CPU rasters
+// Tries the disk cache first and stores fresh decodes there.
+// AICON files missing from the disk cache return ICON_DECODE_MAIN_THREAD -
+// Imlib2 isn't thread safe, see decode_aicon_file().
+// OWNERSHIP: On ICON_DECODE_OK caller frees dec with icon_decoded_free()
+IconDecodeResult icon_decode_file(const char *icon_path, IconDecoded *dec) {
+    memset(dec, 0, sizeof(*dec));
+
+    uint8_t *data;
+    long size;
+    if (icon_load_file(icon_path, &data, &size)) {
+        log_error("[ERROR] icon_core.c:create_icon_images() - Failed to load icon file: %s", icon_path);
+        return ICON_DECODE_FAILED;
+    }
+
+    // Decoded in an earlier session? Use the stored pixels instead
+    // (AICON too - the lookup is CPU only)
+    uint64_t key = icon_disk_cache_key(data, size);
+    if (icon_disk_cache_load(key, dec)) {
+        free(data);
+        return ICON_DECODE_OK;
+    }
+
+    // Check for AICON format (PNG container)
+    if (size >= 5 && memcmp(data, "AICON", 5) == 0) {
+        free(data);
+        return ICON_DECODE_MAIN_THREAD;
+    }
+
+    IconDecodeResult result = decode_icon_data(icon_path, data, size, dec);
+    if (result == ICON_DECODE_OK) icon_disk_cache_store(key, dec);
+    return result;
+}
+
+// Decode an AICON on the main thread and store it in the disk cache,
+// so later sessions take the fast path in icon_decode_file()
+// OWNERSHIP: On ICON_DECODE_OK caller frees dec with icon_decoded_free()
+static IconDecodeResult decode_aicon_file(const char *icon_path, IconDecoded *dec) {
+    memset(dec, 0, sizeof(*dec));
+
+    uint8_t *data;
+    long size;
+    if (icon_load_file(icon_path, &data, &size)) {
+        log_error("[ERROR] icon_core.c:create_icon_images() - Failed to load icon file: %s", icon_path);
+        return ICON_DECODE_FAILED;
+    }
+
+    uint64_t key = icon_disk_cache_key(data, size);
+    int failed = icon_decode_aicon(data, size, dec, icon_path);
+    free(data);
+    if (failed) {
+        icon_decoded_free(dec);
+        return ICON_DECODE_FAILED;
+    }
+    icon_disk_cache_store(key, dec);
+    return ICON_DECODE_OK;
+}
+
+// Load icon images from .info file and create Pictures
+// Files sharing a .info (deficons) share one decoded image - see icon_cache.c
+void create_icon_images(FileIcon *icon, RenderContext *ctx) {
+    if (!icon || !ctx) return;
+
+    const char *icon_path = icon->path;
+    if (!strstr(icon_path, ".info")) {
+        icon_path = (icon->type == TYPE_DRAWER || icon->type == TYPE_ICONIFIED) ?
+                    def_drawer_path : def_tool_path;
+    }
+
+    // Key by mtime and size too, so an edited .info is decoded again
+    struct stat st;
+    bool have_stat = (stat(icon_path, &st) == 0);
+    if (have_stat && icon_cache_acquire(icon, icon_path, &st)) return;
+
+    // Decoded ahead by the worker pool (drawer opening), or decode now
+    IconDecoded dec;
+    IconDecodeResult result;
+    if (!icon_prefetch_take(icon_path, &dec, &result)) {
+        result = icon_decode_file(icon_path, &dec);
+    }
+
+    if (result == ICON_DECODE_MAIN_THREAD) {
+        result = decode_aicon_file(icon_path, &dec);
+    }
+    if (result == ICON_DECODE_OK) {
+        icon_upload_decoded(icon, ctx, &dec);
+        icon_decoded_free(&dec);
+    }
+    if (have_stat) icon_cache_insert(icon, icon_path, &st);
 }
 
 // Create and initialize a FileIcon structure with loaded images
@@ -658,6 +636,7 @@ FileIcon* create_file_icon(const char* path, int x, int y, IconType type,
     icon->last_click_time = 0;
     icon->iconified_canvas = NULL;
     icon->render_error_logged = false;
+    icon_update_label_width(icon);
 
     // Load icon images from .info file
     create_icon_images(icon, ctx);
@@ -666,6 +645,24 @@ FileIcon* create_file_icon(const char* path, int x, int y, IconType type,
     return icon;
 }
 
+// Measure the label once and keep it on the icon (layout, hit tests and
+// rendering all read label_width). Call after every label change.
+// -1 = not measured yet (no font loaded) - icon_label_width() retries.
+void icon_update_label_width(FileIcon *icon) {
+    if (!icon) return;
+    if (font_manager_get_height() <= 0) {
+        icon->label_width = -1;
+        return;
+    }
+    icon->label_width = font_manager_text_width(icon->label ? icon->label : "");
+}
+
+int icon_label_width(FileIcon *icon) {
+    if (!icon) return 0;
+    if (icon->label_width < 0) icon_update_label_width(icon);
+    return max(icon->label_width, 0);
+}
+
 // Complete cleanup - frees Pictures, paths, label, and icon struct
 // OWNERSHIP: Frees everything including the FileIcon structure itself
 void destroy_file_icon(FileIcon* icon) {
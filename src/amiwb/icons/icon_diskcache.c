@@ -0,0 +1,224 @@
+// File: icon_diskcache.c
+// Pre-rasterized icons on disk (~/.cache/amiwb/icons)
+// Decoding a .info (planar conversion, GlowIcon RLE) costs far more than
+// reading finished pixels. The first decode of a file's contents writes the
+// ARGB32 normal and selected rasters next to a small header; later starts
+// mmap that file and copy the rasters out. Files are keyed by a hash of the
+// .info contents, so renamed or copied icons hit too and edited ones simply
+// miss. CPU only - called from the decoder threads (icon_workers.c).
+#include "icon_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// ============================================================================
+// Cache File Format
+// ============================================================================
+
+#define DISK_CACHE_MAGIC "AMIWBIC"
+#define DISK_CACHE_VERSION 3        // Bump when decoders change their output
+#define DISK_CACHE_BYTE_ORDER 0x01020304u   // Reads back swapped on a foreign host
+
+typedef enum {
+    SEL_NONE = 0,                   // No selected image
+    SEL_SAME = 1,                   // Selected shows the normal image
+    SEL_OWN = 2,                    // Selected pixels follow the normal ones
+    SEL_SHADED = 3                  // Normal image darkened at upload
+} DiskSelMode;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;            // DISK_CACHE_BYTE_ORDER as written
+    uint16_t width, height;
+    uint16_t sel_width, sel_height;
+    uint32_t sel_mode;              // DiskSelMode
+} DiskCacheHeader;                  // Followed by width*height then sel pixels
+
+// ============================================================================
+// Module-Private State
+// ============================================================================
+
+static bool g_dir_ready = false;
+static bool g_dir_failed = false;   // No HOME or mkdir failed - stop trying
+static pthread_mutex_t g_dir_lock = PTHREAD_MUTEX_INITIALIZER;  // Decoder threads
+
+// ============================================================================
+// Internal Implementation
+// ============================================================================
+
+static bool cache_file_path(uint64_t key, char *out, size_t out_size) {
+    const char *home = getenv("HOME");
+    if (!home) return false;
+    snprintf(out, out_size, "%s/%s/%016llx.argb", home, ICON_CACHE_DIR_USER,
+             (unsigned long long)key);
+    return true;
+}
+
+// mkdir -p ~/.cache/amiwb/icons (once)
+static bool make_cache_dir(void) {
+    if (g_dir_ready) return true;
+    if (g_dir_failed) return false;
+
+    const char *home = getenv("HOME");
+    if (!home) {
+        g_dir_failed = true;
+        return false;
+    }
+
+    char path[PATH_SIZE];
+    snprintf(path, sizeof(path), "%s/%s", home, ICON_CACHE_DIR_USER);
+    for (char *p = path + strlen(home) + 1; ; p++) {
+        if (*p != '/' && *p != '\0') continue;
+        char saved = *p;
+        *p = '\0';
+        if (mkdir(path, 0700) != 0 && errno != EEXIST) {
+            log_error("[ICONCACHE] Cannot create %s - disk icon cache disabled", path);
+            g_dir_failed = true;
+            return false;
+        }
+        *p = saved;
+        if (saved == '\0') break;
+    }
+    g_dir_ready = true;
+    return true;
+}
+
+static bool ensure_cache_dir(void) {
+    pthread_mutex_lock(&g_dir_lock);
+    bool ready = make_cache_dir();
+    pthread_mutex_unlock(&g_dir_lock);
+    return ready;
+}
+
+// Copy width*height mapped pixels into a fresh raster
+static bool copy_raster(IconRaster *out, const uint32_t *pixels, int width, int height) {
+    if (!icon_raster_alloc(out, width, height)) return false;
+    memcpy(out->pixels, pixels, (size_t)width * height * 4);
+    return true;
+}
+
+static bool valid_dims(int width, int height) {
+    return width > 0 && width <= 0xFFFF && height > 0 && height <= 0xFFFF;
+}
+
+// ============================================================================
+// Public API (internal to icons module)
+// ============================================================================
+
+// 64-bit FNV-1a of the .info contents (plus length) - the cache key
+uint64_t icon_disk_cache_key(const uint8_t *data, long size) {
+    uint64_t h = 14695981039346656037ULL;
+    for (long i = 0; i < size; i++) {
+        h = (h ^ data[i]) * 1099511628211ULL;
+    }
+    return (h ^ (uint64_t)size) * 1099511628211ULL;
+}
+
+// Fill dec from the cache file for key
+// Returns false on a miss (or a stale/foreign file) - caller decodes
+bool icon_disk_cache_load(uint64_t key, IconDecoded *dec) {
+    char path[PATH_SIZE];
+    if (!dec || !cache_file_path(key, path, sizeof(path))) return false;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(DiskCacheHeader)) {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    const DiskCacheHeader *hdr = map;
+    const uint32_t *pixels = (const uint32_t *)(hdr + 1);
+    size_t normal_px = (size_t)hdr->width * hdr->height;
+    size_t sel_px = (hdr->sel_mode == SEL_OWN) ? (size_t)hdr->sel_width * hdr->sel_height : 0;
+    bool ok = memcmp(hdr->magic, DISK_CACHE_MAGIC, sizeof(DISK_CACHE_MAGIC)) == 0 &&
+              hdr->version == DISK_CACHE_VERSION &&
+              hdr->byte_order == DISK_CACHE_BYTE_ORDER &&
+              hdr->sel_mode <= SEL_SHADED &&
+              valid_dims(hdr->width, hdr->height) &&
+              (hdr->sel_mode != SEL_OWN || valid_dims(hdr->sel_width, hdr->sel_height)) &&
+              (size_t)st.st_size == sizeof(DiskCacheHeader) + (normal_px + sel_px) * 4;
+
+    memset(dec, 0, sizeof(*dec));
+    if (ok) ok = copy_raster(&dec->normal, pixels, hdr->width, hdr->height);
+    if (ok) {
+        switch (hdr->sel_mode) {
+        case SEL_OWN:
+            ok = copy_raster(&dec->selected, pixels + normal_px, hdr->sel_width, hdr->sel_height);
+            dec->sel_kind = ICON_SELECTED_OWN;
+            break;
+        case SEL_SHADED: dec->sel_kind = ICON_SELECTED_SHADED; break;
+        case SEL_SAME:   dec->sel_kind = ICON_SELECTED_NORMAL; break;
+        default:         dec->sel_kind = ICON_SELECTED_NONE; break;
+        }
+    }
+    if (!ok) icon_decoded_free(dec);
+
+    munmap(map, st.st_size);
+    return ok;
+}
+
+// Write freshly decoded rasters to the cache file for key
+// Written to a temp file and renamed, so readers never see half a file
+void icon_disk_cache_store(uint64_t key, const IconDecoded *dec) {
+    if (!dec || !dec->normal.pixels) return;
+    if (!valid_dims(dec->normal.width, dec->normal.height)) return;
+
+    DiskCacheHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, DISK_CACHE_MAGIC, sizeof(DISK_CACHE_MAGIC));
+    hdr.version = DISK_CACHE_VERSION;
+    hdr.byte_order = DISK_CACHE_BYTE_ORDER;
+    hdr.width = dec->normal.width;
+    hdr.height = dec->normal.height;
+    switch (dec->sel_kind) {
+    case ICON_SELECTED_OWN:
+        if (!dec->selected.pixels || !valid_dims(dec->selected.width, dec->selected.height)) {
+            return;
+        }
+        hdr.sel_mode = SEL_OWN;
+        hdr.sel_width = dec->selected.width;
+        hdr.sel_height = dec->selected.height;
+        break;
+    case ICON_SELECTED_SHADED: hdr.sel_mode = SEL_SHADED; break;
+    case ICON_SELECTED_NORMAL: hdr.sel_mode = SEL_SAME; break;
+    case ICON_SELECTED_NONE:   hdr.sel_mode = SEL_NONE; break;
+    }
+    if (hdr.sel_mode != SEL_OWN && hdr.sel_mode != SEL_NONE) {
+        hdr.sel_width = hdr.width;
+        hdr.sel_height = hdr.height;
+    }
+
+    char path[PATH_SIZE], tmp_path[PATH_SIZE + 32];
+    if (!ensure_cache_dir() || !cache_file_path(key, path, sizeof(path))) return;
+
+    // Per thread temp name - two workers may store the same contents at once
+    snprintf(tmp_path, sizeof(tmp_path), "%s.%d.%lx", path, (int)getpid(),
+             (unsigned long)pthread_self());
+    FILE *f = fopen(tmp_path, "wb");
+    bool ok = (f != NULL);
+    if (ok) {
+        size_t normal_px = (size_t)hdr.width * hdr.height;
+        size_t sel_px = (size_t)hdr.sel_width * hdr.sel_height;
+        ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+             fwrite(dec->normal.pixels, 4, normal_px, f) == normal_px &&
+             (hdr.sel_mode != SEL_OWN || fwrite(dec->selected.pixels, 4, sel_px, f) == sel_px);
+        ok = (fclose(f) == 0) && ok;
+    }
+    if (ok && rename(tmp_path, path) != 0) ok = false;
+    if (!ok) {
+        log_error("[ICONCACHE] Cannot write %s", path);
+        unlink(tmp_path);
+    }
+}
@@ -7,11 +7,10 @@
 // Parse GlowIcon format (IFF FORM/ICON or ToolTypes encoded)
 // This is a large cohesive function that handles RLE decompression, palette parsing,
 // and transparency - kept together per coding_guidelines.md
-int icon_parse_glowicon(Display *dpy, const uint8_t *data, long size, long offset,
-                        Pixmap *normal_out, Pixmap *selected_out,
-                        uint16_t *width_out, uint16_t *height_out,
-                        uint16_t *sel_width_out, uint16_t *sel_height_out,
-                        XRenderPictFormat *fmt, const char *icon_path) {
+// Produces CPU rasters only (safe on decoder threads)
+int icon_parse_glowicon(const uint8_t *data, long size, long offset,
+                        IconRaster *normal_out, IconRaster *selected_out,
+                        const char *icon_path) {
 
     if (offset + 12 > size) return 1;  // Need at least FORM header or marker
 
@@ -39,9 +38,7 @@ int icon_parse_glowicon(Display *dpy, const uint8_t *data, long size, long offse
     ColorIconFace current_face = {0};  // Track current FACE for next IMAG
     int has_face = 0;
     int state_count = 0;
-    Pixmap pixmaps[2] = {0, 0};
-    uint16_t widths[2] = {0, 0};
-    uint16_t heights[2] = {0, 0};
+    IconRaster rasters[2] = {{0}, {0}};
 
     // Storage for the first image's palette to reuse if needed
     uint32_t first_palette[256];
@@ -243,33 +240,14 @@ int icon_parse_glowicon(Display *dpy, const uint8_t *data, long size, long offse
             // The transparency is meant to show through to highlight color
 
 
-            // Create X11 pixmap
-            XVisualInfo vinfo;
-            Pixmap pixmap;
-            XImage *image;
-            if (icon_create_rendering_context(dpy, width, height, &pixmap, &image, &vinfo) == 0) {
-                // Count pixel index usage for debugging
-                int pixel_0_count = 0;
-                int pixel_trans_count = 0;
-
+            // Expand to ARGB (uploaded later on the main thread)
+            IconRaster *raster = &rasters[state_count];
+            if (icon_raster_alloc(raster, width, height)) {
                 for (int y = 0; y < height; y++) {
-                    for (int x = 0; x < width; x++) {
-                        uint8_t pixel = pixels[y * width + x];
-                        if (pixel == 0) pixel_0_count++;
-                        if (pixel == transparent_idx) pixel_trans_count++;
-                        XPutPixel(image, x, y, palette[pixel]);
-                    }
+                    icon_expand_indexed_row(raster->pixels + y * width, pixels + y * width,
+                                            palette, width);
                 }
 
-                GC gc = XCreateGC(dpy, pixmap, 0, NULL);
-                XPutImage(dpy, pixmap, gc, image, 0, 0, 0, 0, width, height);
-                XFreeGC(dpy, gc);
-                XDestroyImage(image);
-
-                pixmaps[state_count] = pixmap;
-                widths[state_count] = width;
-                heights[state_count] = height;
-
                 // Debug: Check transparency for problematic icons
                 const char *basename = strrchr(icon_path, '/');
                 if (basename) basename++; else basename = icon_path;
@@ -334,23 +312,14 @@ int icon_parse_glowicon(Display *dpy, const uint8_t *data, long size, long offse
 
     // Return results
     if (state_count > 0) {
-        *normal_out = pixmaps[0];
-        *width_out = widths[0];
-        *height_out = heights[0];
-
-        if (state_count > 1) {
-            *selected_out = pixmaps[1];
-            *sel_width_out = widths[1];
-            *sel_height_out = heights[1];
-        } else {
-            *selected_out = 0;
-        }
+        *normal_out = rasters[0];
+        *selected_out = rasters[1];  // Empty raster if there is no second state
         return 0;
     }
 
     // Cleanup on failure
     for (int i = 0; i < 2; i++) {
-        if (pixmaps[i]) XFreePixmap(dpy, pixmaps[i]);
+        icon_raster_free(&rasters[i]);
     }
     return 1;
 }
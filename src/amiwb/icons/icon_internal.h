@@ -8,6 +8,7 @@
 #include <X11/Xlib.h>
 #include <X11/extensions/Xrender.h>
 #include <stdint.h>
+#include <sys/stat.h>
 
 // ============================================================================
 // Icon Format Detection
@@ -100,6 +101,36 @@ AmigaIconFormat icon_detect_format(const uint8_t *data, long size, long *form_of
 int icon_load_file(const char *name, uint8_t **data, long *size);
 int icon_parse_header(const uint8_t *header, long size, uint16_t *width, uint16_t *height, uint16_t *depth);
 
+// ============================================================================
+// Decoded Images (CPU side - no X calls, safe on worker threads)
+// ============================================================================
+
+// Packed ARGB32 pixels in host order (0xAARRGGBB), width * height
+typedef struct {
+    uint32_t *pixels;
+    int width, height;
+} IconRaster;
+
+typedef enum {
+    ICON_SELECTED_NONE = 0,     // No selected image
+    ICON_SELECTED_NORMAL,       // Selected shows the normal image
+    ICON_SELECTED_SHADED,       // Normal image darkened at upload (server side)
+    ICON_SELECTED_OWN           // Own selected raster
+} IconSelectedKind;
+
+// Everything decoding one .info produces
+typedef struct {
+    IconRaster normal;
+    IconRaster selected;        // ICON_SELECTED_OWN only
+    IconSelectedKind sel_kind;
+} IconDecoded;
+
+typedef enum {
+    ICON_DECODE_OK = 0,
+    ICON_DECODE_FAILED,
+    ICON_DECODE_MAIN_THREAD     // AICON not in the disk cache - Imlib2 decodes on the main thread
+} IconDecodeResult;
+
 // ============================================================================
 // Rendering Infrastructure (icon_render.c)
 // ============================================================================
@@ -108,37 +139,73 @@ Picture icon_create_picture(Display *dpy, Pixmap pixmap, XRenderPictFormat *fmt)
 int icon_create_rendering_context(Display *dpy, uint16_t width, uint16_t height,
                                   Pixmap *pixmap_out, XImage **image_out, XVisualInfo *vinfo_out);
 Pixmap icon_create_darkened_pixmap(Display *dpy, Pixmap src, int width, int height);
-void icon_cleanup_partial(Display *dpy, FileIcon *icon);
 void icon_free_pictures(FileIcon* icon);
 
+bool icon_raster_alloc(IconRaster *raster, int width, int height);
+void icon_raster_free(IconRaster *raster);
+void icon_decoded_free(IconDecoded *dec);
+void icon_upload_decoded(FileIcon *icon, RenderContext *ctx, const IconDecoded *dec);
+
+// Planar/indexed pixels to ARGB32 (table driven)
+void icon_planar_to_chunky_row(const uint8_t *row, long plane_size, int depth,
+                               int width, uint8_t *indices);
+void icon_expand_indexed_row(uint32_t *dst, const uint8_t *indices,
+                             const uint32_t palette[256], int width);
+
 // Main rendering dispatcher
-int icon_render(Display *dpy, Pixmap *pixmap_out, const uint8_t *data, uint16_t width,
+int icon_render(IconRaster *out, const uint8_t *data, uint16_t width,
                uint16_t height, uint16_t depth, AmigaIconFormat format, long data_size);
 
+// ============================================================================
+// Decoding Pipeline (icon_core.c) - any thread
+// ============================================================================
+
+IconDecodeResult icon_decode_file(const char *icon_path, IconDecoded *dec);
+
+// ============================================================================
+// Shared Decoded Images (icon_cache.c)
+// ============================================================================
+
+bool icon_cache_acquire(FileIcon *icon, const char *icon_path, const struct stat *st);
+void icon_cache_insert(FileIcon *icon, const char *icon_path, const struct stat *st);
+void icon_cache_release(FileIcon *icon);
+bool icon_cache_has_path(const char *icon_path);
+
+// ============================================================================
+// Pre-rasterized Icons on Disk (icon_diskcache.c) - any thread
+// ============================================================================
+
+uint64_t icon_disk_cache_key(const uint8_t *data, long size);
+bool icon_disk_cache_load(uint64_t key, IconDecoded *dec);
+void icon_disk_cache_store(uint64_t key, const IconDecoded *dec);
+
+// ============================================================================
+// Decoding Worker Pool (icon_workers.c)
+// ============================================================================
+
+bool icon_prefetch_take(const char *icon_path, IconDecoded *dec, IconDecodeResult *result);
+
 // ============================================================================
 // OS 1.3 Format (icon_os13.c)
 // ============================================================================
 
 void icon_get_os13_palette(unsigned long colors[4]);
 void icon_get_mwb_palette(unsigned long colors[8]);
-int icon_render_os13(Display *dpy, Pixmap *pixmap_out, const uint8_t *data,
-                     uint16_t width, uint16_t height);
+int icon_render_os13(IconRaster *out, const uint8_t *data, uint16_t width, uint16_t height);
 
 // ============================================================================
 // GlowIcon/ColorIcon Format (icon_glowicon.c)
 // ============================================================================
 
-int icon_parse_glowicon(Display *dpy, const uint8_t *data, long size, long offset,
-                        Pixmap *normal_out, Pixmap *selected_out,
-                        uint16_t *width_out, uint16_t *height_out,
-                        uint16_t *sel_width_out, uint16_t *sel_height_out,
-                        XRenderPictFormat *fmt, const char *icon_path);
+int icon_parse_glowicon(const uint8_t *data, long size, long offset,
+                        IconRaster *normal_out, IconRaster *selected_out,
+                        const char *icon_path);
 
 // ============================================================================
 // AICON Format (icon_aicon.c)
 // ============================================================================
 
-int icon_load_aicon(FileIcon *icon, RenderContext *ctx,
-                    const uint8_t *data, long size);
+int icon_decode_aicon(const uint8_t *data, long size, IconDecoded *dec,
+                      const char *icon_path);
 
 #endif
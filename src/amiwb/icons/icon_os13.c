@@ -1,6 +1,7 @@
 // File: icon_os13.c
 // OS 1.3 classic icon format support
 #include "icon_internal.h"
+#include <stdlib.h>
 #include <string.h>
 
 // Helper function to get MagicWB 8-color palette
@@ -31,16 +32,7 @@ void icon_get_os13_palette(unsigned long colors[4]) {
 }
 
 // Render OS1.3 icon (2 bitplanes, 4 colors, transparent background)
-int icon_render_os13(Display *dpy, Pixmap *pixmap_out, const uint8_t *data,
-                     uint16_t width, uint16_t height) {
-    Pixmap pixmap;
-    XImage *image;
-    XVisualInfo vinfo;
-    if (icon_create_rendering_context(dpy, width, height, &pixmap, &image, &vinfo) != 0) {
-        return 1;
-    }
-    memset(image->data, 0, width * height * 4);
-
+int icon_render_os13(IconRaster *out, const uint8_t *data, uint16_t width, uint16_t height) {
     // OS1.3 color palette
     unsigned long colors[4];
     icon_get_os13_palette(colors);
@@ -58,28 +50,19 @@ int icon_render_os13(Display *dpy, Pixmap *pixmap_out, const uint8_t *data,
     long second_plane_offset = plane_size;
 
 
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            int color = 0;
-
-            // Read plane 0
-            long offset = y * row_bytes + (x >> 3);
-            uint8_t byte = data[offset];
-            if (byte & (1 << (7 - (x & 7)))) color |= 1;
-
-            // Read plane 1 from adjusted offset
-            offset = second_plane_offset + y * row_bytes + (x >> 3);
-            byte = data[offset];
-            if (byte & (1 << (7 - (x & 7)))) color |= 2;
+    uint32_t lut[256];
+    for (int i = 0; i < 256; i++) lut[i] = (uint32_t)colors[i & 3];
 
-            XPutPixel(image, x, y, colors[color]);
-        }
+    uint8_t *indices = malloc(width + 8);
+    if (!indices) return 1;
+    if (!icon_raster_alloc(out, width, height)) {
+        free(indices);
+        return 1;
     }
-
-    GC gc = XCreateGC(dpy, pixmap, 0, NULL);
-    XPutImage(dpy, pixmap, gc, image, 0, 0, 0, 0, width, height);
-    XFreeGC(dpy, gc);
-    XDestroyImage(image);
-    *pixmap_out = pixmap;
+    for (int y = 0; y < height; y++) {
+        icon_planar_to_chunky_row(data + y * row_bytes, second_plane_offset, 2, width, indices);
+        icon_expand_indexed_row(out->pixels + (size_t)y * width, indices, lut, width);
+    }
+    free(indices);
     return 0;
 }
@@ -7,6 +7,20 @@
 
 typedef enum IconType { TYPE_FILE, TYPE_DRAWER, TYPE_ICONIFIED, TYPE_DEVICE } IconType;
 
+// Decoded Pictures shared by all icons of one .info file (icon_cache.c)
+typedef struct IconImage IconImage;
+
+// What the renderer last drew for an icon (retained redraw in rnd_canvas.c)
+// Rectangle is in content coordinates, so it stays valid across scrolling
+typedef struct {
+    Picture picture;            // current_picture when drawn (None = never drawn)
+    bool selected;              // Selection state when drawn (list view highlight)
+    int x, y;                   // Icon position when drawn
+    unsigned label_hash;        // Label contents when drawn
+    int rect_x, rect_y;         // Pixels covered by picture and label
+    int rect_w, rect_h;
+} IconDrawnState;
+
 typedef struct {
     char *label;                // Icon label (filename or custom)
     char *path;                 // File/directory path
@@ -14,15 +28,17 @@ typedef struct {
     int x, y;                   // Position on canvas
     int width, height;          // Normal icon dimensions
     int sel_width, sel_height;  // Selected icon dimensions (may differ from normal)
-    int label_width;            // Cached label text width for layout
+    int label_width;            // Cached label text width (icon_label_width)
     bool selected;              // Selection state
     Picture normal_picture;     // Normal state picture
     Picture selected_picture;   // Selected state picture
     Picture current_picture;    // Current displayed picture
+    IconImage *image;           // Shared owner of the Pictures (NULL = icon owns them)
     Window display_window;      // Window ID of display canvas (desktop or window)
     Time last_click_time;       // Timestamp of last click for double-click detection
     Canvas *iconified_canvas;   // Pointer to the iconified canvas (for TYPE_ICONIFIED)
     bool render_error_logged;   // Flag to prevent repeated render error logging
+    IconDrawnState drawn;       // Last rendered state (retained redraw)
 } FileIcon;
 
 // Icon lifecycle management
@@ -30,7 +46,16 @@ FileIcon* create_file_icon(const char* path, int x, int y, IconType type,
                            Window display_window, RenderContext* ctx);
 void destroy_file_icon(FileIcon* icon);
 
+// Label width cache - update after changing icon->label
+void icon_update_label_width(FileIcon *icon);
+int icon_label_width(FileIcon *icon);
+
 // Icon rendering (public for workbench module)
 void create_icon_images(FileIcon* icon, RenderContext* ctx);
 
+// Background decoding of a drawer's icons (icon_workers.c)
+// Prefetch the .info paths before creating the icons, finish afterwards
+void icon_prefetch(const char **icon_paths, int count);
+void icon_prefetch_finish(void);
+
 #endif
@@ -1,6 +1,8 @@
 // File: icon_render.c
 // Icon rendering infrastructure and format dispatching
 #include "icon_internal.h"
+#include <X11/Xutil.h>
+#include <pthread.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -38,96 +40,222 @@ int icon_create_rendering_context(Display *dpy, uint16_t width, uint16_t height,
     return 0;
 }
 
-// Helper function to clean up partially loaded icon
-void icon_cleanup_partial(Display *dpy, FileIcon *icon) {
-    if (icon->normal_picture) {
-        XRenderFreePicture(dpy, icon->normal_picture);
-        icon->normal_picture = None;
-    }
-    // NOTE: normal_pixmap is freed by the caller at the end of create_icon_images
-    // Do NOT free it here to avoid double-free
+// ============================================================================
+// CPU Rasters
+// ============================================================================
+
+// Allocate an uninitialized width x height raster - false on bad size or OOM
+bool icon_raster_alloc(IconRaster *raster, int width, int height) {
+    raster->pixels = NULL;
+    raster->width = raster->height = 0;
+    if (width <= 0 || height <= 0) return false;
+    raster->pixels = malloc((size_t)width * height * 4);
+    if (!raster->pixels) return false;
+    raster->width = width;
+    raster->height = height;
+    return true;
 }
 
-// Create darkened version of icon for selected state
-// Darkens by 20% (multiply RGB by 0.8) but keeps alpha unchanged
-Pixmap icon_create_darkened_pixmap(Display *dpy, Pixmap src, int width, int height) {
-    // Guard against invalid pixmap - don't try to render garbage
-    if (src == None || src == 0) {
-        return 0;
+void icon_raster_free(IconRaster *raster) {
+    if (!raster) return;
+    free(raster->pixels);
+    raster->pixels = NULL;
+    raster->width = raster->height = 0;
+}
+
+void icon_decoded_free(IconDecoded *dec) {
+    if (!dec) return;
+    icon_raster_free(&dec->normal);
+    icon_raster_free(&dec->selected);
+    dec->sel_kind = ICON_SELECTED_NONE;
+}
+
+// ============================================================================
+// Planar to Chunky
+// ============================================================================
+
+// g_plane_spread[b]: the 8 bits of one plane byte spread to one byte per
+// pixel, leftmost pixel first in memory, each 0 or 1. OR-ing the entry of
+// plane p shifted left by p builds 8 color indices at once - no byte lane
+// carries into its neighbour since every lane stays below 256.
+static uint64_t g_plane_spread[256];
+static pthread_once_t g_plane_spread_once = PTHREAD_ONCE_INIT;  // Decoder threads
+
+static void init_plane_spread(void) {
+    for (int b = 0; b < 256; b++) {
+        uint8_t lanes[8];
+        for (int i = 0; i < 8; i++) lanes[i] = (b >> (7 - i)) & 1;
+        memcpy(&g_plane_spread[b], lanes, sizeof(lanes));
     }
+}
 
-    // Get the image data from source pixmap
-    XImage *src_img = XGetImage(dpy, src, 0, 0, width, height, AllPlanes, ZPixmap);
-    if (!src_img) return 0;
+static inline uint64_t gather_planes(const uint8_t *row, long plane_size, int depth, int col) {
+    uint64_t lanes = 0;
+    for (int p = 0; p < depth; p++) {
+        lanes |= g_plane_spread[row[p * plane_size + col]] << p;
+    }
+    return lanes;
+}
 
-    // Create destination pixmap
-    Pixmap dark = XCreatePixmap(dpy, src, width, height, 32);
+// One row of bitplanes to one color index per pixel
+// row points at the row in plane 0; the other planes follow plane_size apart
+// depth must be 1-8 - a ninth plane would spill into the next pixel's lane
+void icon_planar_to_chunky_row(const uint8_t *row, long plane_size, int depth,
+                               int width, uint8_t *indices) {
+    pthread_once(&g_plane_spread_once, init_plane_spread);
 
-    // Create XImage for the darkened version
-    XImage *dark_img = XCreateImage(dpy, DefaultVisual(dpy, DefaultScreen(dpy)),
-                                    32, ZPixmap, 0, NULL, width, height, 32, 0);
-    if (!dark_img) {
-        XDestroyImage(src_img);
-        XFreePixmap(dpy, dark);
-        return 0;
+    int full = width >> 3;
+    for (int col = 0; col < full; col++) {
+        uint64_t lanes = gather_planes(row, plane_size, depth, col);
+        memcpy(indices + col * 8, &lanes, 8);
     }
+    if (width & 7) {
+        // Rows are word padded - the byte for the last pixels always exists
+        uint64_t lanes = gather_planes(row, plane_size, depth, full);
+        memcpy(indices + full * 8, &lanes, width & 7);
+    }
+}
 
-    dark_img->data = malloc(dark_img->bytes_per_line * height);
-    if (!dark_img->data) {
-        XDestroyImage(src_img);
-        XDestroyImage(dark_img);
-        XFreePixmap(dpy, dark);
-        return 0;
+// Palette lookup of one row of color indices
+void icon_expand_indexed_row(uint32_t *dst, const uint8_t *indices,
+                             const uint32_t palette[256], int width) {
+    for (int x = 0; x < width; x++) dst[x] = palette[indices[x]];
+}
+
+// ============================================================================
+// Upload (main thread)
+// ============================================================================
+
+static XVisualInfo *icon_visual(Display *dpy) {
+    static XVisualInfo vinfo;
+    static bool found = false;
+    if (!found) {
+        if (!XMatchVisualInfo(dpy, DefaultScreen(dpy), ICON_RENDER_DEPTH, TrueColor, &vinfo)) {
+            log_error("[ERROR] No %d-bit TrueColor visual found for icon", ICON_RENDER_DEPTH);
+            return NULL;
+        }
+        found = true;
     }
+    return &vinfo;
+}
 
-    // Darken each pixel by 20% (multiply RGB by 0.8) but keep alpha unchanged
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            unsigned long pixel = XGetPixel(src_img, x, y);
-
-            // Extract ARGB components
-            uint8_t a = (pixel >> 24) & 0xFF;
-            uint8_t r = (pixel >> 16) & 0xFF;
-            uint8_t g = (pixel >> 8) & 0xFF;
-            uint8_t b = pixel & 0xFF;
-
-            // Only darken if not transparent
-            if (a > 0) {
-                // Darken by 20% (multiply by 0.8)
-                r = (r * 4) / 5;
-                g = (g * 4) / 5;
-                b = (b * 4) / 5;
-            }
-
-            // Reconstruct pixel
-            unsigned long dark_pixel = (a << 24) | (r << 16) | (g << 8) | b;
-            XPutPixel(dark_img, x, y, dark_pixel);
+// Put a raster into a new 32-bit pixmap (None on failure)
+// The XImage borrows the raster's pixels when the display takes host byte
+// order; otherwise XPutPixel converts into a scratch buffer
+static Pixmap raster_to_pixmap(Display *dpy, const IconRaster *raster) {
+    XVisualInfo *vinfo = icon_visual(dpy);
+    if (!vinfo || !raster->pixels) return None;
+
+    XImage *image = XCreateImage(dpy, vinfo->visual, ICON_RENDER_DEPTH, ZPixmap, 0,
+                                 NULL, raster->width, raster->height, 32, 0);
+    if (!image) return None;
+
+    const uint16_t probe = 1;
+    int host_order = (*(const uint8_t *)&probe == 1) ? LSBFirst : MSBFirst;
+    bool borrowed = (image->bits_per_pixel == 32 && image->byte_order == host_order &&
+                     image->bytes_per_line == raster->width * 4);
+    if (borrowed) {
+        image->data = (char *)raster->pixels;
+    } else {
+        image->data = malloc((size_t)image->bytes_per_line * raster->height);
+        if (!image->data) {
+            XDestroyImage(image);
+            return None;
+        }
+        for (int y = 0; y < raster->height; y++) {
+            const uint32_t *row = raster->pixels + (size_t)y * raster->width;
+            for (int x = 0; x < raster->width; x++) XPutPixel(image, x, y, row[x]);
         }
     }
 
-    // Put the darkened image into the pixmap
-    GC gc = XCreateGC(dpy, dark, 0, NULL);
-    XPutImage(dpy, dark, gc, dark_img, 0, 0, 0, 0, width, height);
+    Pixmap pixmap = XCreatePixmap(dpy, DefaultRootWindow(dpy),
+                                  raster->width, raster->height, ICON_RENDER_DEPTH);
+    GC gc = XCreateGC(dpy, pixmap, 0, NULL);
+    XPutImage(dpy, pixmap, gc, image, 0, 0, 0, 0, raster->width, raster->height);
     XFreeGC(dpy, gc);
+    if (borrowed) image->data = NULL;  // Raster keeps its pixels
+    XDestroyImage(image);
+    return pixmap;
+}
 
-    // Cleanup
-    XDestroyImage(src_img);
-    XDestroyImage(dark_img);
+// Turn decoded rasters into the icon's Pictures (the only X work of a load)
+void icon_upload_decoded(FileIcon *icon, RenderContext *ctx, const IconDecoded *dec) {
+    if (!icon || !ctx || !dec || !dec->normal.pixels) return;
 
-    return dark;
+    Pixmap normal = raster_to_pixmap(ctx->dpy, &dec->normal);
+    if (!normal) return;
+    icon->normal_picture = XRenderCreatePicture(ctx->dpy, normal, ctx->fmt, 0, NULL);
+    icon->width = dec->normal.width;
+    icon->height = dec->normal.height;
+
+    switch (dec->sel_kind) {
+    case ICON_SELECTED_OWN: {
+        Pixmap selected = raster_to_pixmap(ctx->dpy, &dec->selected);
+        if (selected) {
+            // Ownership transfer: icon_create_picture() takes and frees the pixmap
+            icon->selected_picture = icon_create_picture(ctx->dpy, selected, ctx->fmt);
+            icon->sel_width = dec->selected.width;
+            icon->sel_height = dec->selected.height;
+        }
+        break;
+    }
+    case ICON_SELECTED_SHADED: {
+        Pixmap dark = icon_create_darkened_pixmap(ctx->dpy, normal, icon->width, icon->height);
+        // Fallback to same image if darkening fails
+        icon->selected_picture = dark ? icon_create_picture(ctx->dpy, dark, ctx->fmt)
+                                      : icon->normal_picture;
+        icon->sel_width = icon->width;
+        icon->sel_height = icon->height;
+        break;
+    }
+    case ICON_SELECTED_NORMAL:
+        icon->selected_picture = icon->normal_picture;
+        icon->sel_width = icon->width;
+        icon->sel_height = icon->height;
+        break;
+    case ICON_SELECTED_NONE:
+        break;
+    }
+
+    XFreePixmap(ctx->dpy, normal);
+    icon->current_picture = icon->normal_picture;
 }
 
-// Main planar icon renderer for OS3/MWB formats (variable depth)
-// Converts Amiga planar format to chunky RGB and renders to X11 pixmap
-int icon_render(Display *dpy, Pixmap *pixmap_out, const uint8_t *data, uint16_t width, uint16_t height, uint16_t depth, AmigaIconFormat format, long data_size) {
-    XVisualInfo vinfo;
-    Pixmap pixmap;
-    XImage *image;
-    if (icon_create_rendering_context(dpy, width, height, &pixmap, &image, &vinfo) != 0) {
-        return 1;
+// Create darkened version of icon for selected state
+// Darkens by 20% (multiply RGB by 0.8) but keeps alpha unchanged
+// Done by the server: black at 20% composited ATOP the copy scales color
+// by 0.8 and leaves alpha alone - no image download, no CPU pass
+Pixmap icon_create_darkened_pixmap(Display *dpy, Pixmap src, int width, int height) {
+    // Guard against invalid pixmap - don't try to render garbage
+    if (src == None || src == 0) {
+        return 0;
     }
-    memset(image->data, 0, width * height * 4);
 
+    // One shared solid source for every icon
+    static Picture shade = None;
+    if (shade == None) {
+        XRenderColor black_20 = {0, 0, 0, 0x3333};
+        shade = XRenderCreateSolidFill(dpy, &black_20);
+    }
+
+    XRenderPictFormat *fmt = XRenderFindStandardFormat(dpy, PictStandardARGB32);
+    if (!fmt || shade == None) return 0;
+
+    Pixmap dark = XCreatePixmap(dpy, src, width, height, 32);
+    Picture src_pic = XRenderCreatePicture(dpy, src, fmt, 0, NULL);
+    Picture dark_pic = XRenderCreatePicture(dpy, dark, fmt, 0, NULL);
+
+    XRenderComposite(dpy, PictOpSrc, src_pic, None, dark_pic, 0, 0, 0, 0, 0, 0, width, height);
+    XRenderComposite(dpy, PictOpAtop, shade, None, dark_pic, 0, 0, 0, 0, 0, 0, width, height);
+
+    XRenderFreePicture(dpy, src_pic);
+    XRenderFreePicture(dpy, dark_pic);
+    return dark;
+}
+
+// Main planar icon renderer for OS3/MWB formats (variable depth)
+// Converts Amiga planar format to chunky ARGB in a CPU raster (any thread)
+int icon_render(IconRaster *out, const uint8_t *data, uint16_t width, uint16_t height, uint16_t depth, AmigaIconFormat format, long data_size) {
     // Icons can use true alpha; index 0 would be transparent. We use a
     // gray fill for now to match classic look; adjust when alpha lands.
     // unsigned long colors[8] = {0x00000000UL, 0xFF000000UL, 0xFFFFFFFFUL, 0xFF6666BBUL, 0xFF999999UL, 0xFFBBBBBBUL, 0xFFBBAA99UL, 0xFFFFAA22UL};
@@ -146,6 +274,14 @@ int icon_render(Display *dpy, Pixmap *pixmap_out, const uint8_t *data, uint16_t
         // OS3/MWB icons use 8 colors
         icon_get_mwb_palette(colors);
     }
+    // Valid depth range is 1-8 for classic Amiga icons. The OS2.x/3.x Image
+    // depth comes straight from the file, and the 8-pixel lanes built by
+    // icon_planar_to_chunky_row() only hold 8 planes
+    if (depth == 0 || depth > 8) {
+        log_error("[ERROR] Unsupported icon depth %u (1-8 planes)", (unsigned)depth);
+        return 1;
+    }
+
     int row_bytes;
     long plane_size, total_data_size;
     icon_calculate_plane_dimensions(width, height, depth, &row_bytes, &plane_size, &total_data_size);
@@ -155,34 +291,24 @@ int icon_render(Display *dpy, Pixmap *pixmap_out, const uint8_t *data, uint16_t
     long required_size = plane_size * depth;
     if (data_size < required_size) {
         log_error("[ERROR] Icon data too small: have %ld, need %ld bytes", data_size, required_size);
-        XDestroyImage(image);
-        XFreePixmap(dpy, pixmap);
         return 1;
     }
 
+    // Palette for every index a row can produce (only the low 3 bits count)
+    uint32_t lut[256];
+    for (int i = 0; i < 256; i++) lut[i] = (uint32_t)colors[i & 7];
+
+    uint8_t *indices = malloc(width + 8);
+    if (!indices) return 1;
+    if (!icon_raster_alloc(out, width, height)) {
+        free(indices);
+        return 1;
+    }
+    // required_size check above covers every byte the rows read
     for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            int color = 0;
-            for (int p = 0; p < depth; p++) {
-                long offset = p * plane_size + y * row_bytes + (x >> 3);
-                // Safety check to prevent reading beyond buffer
-                if (offset >= data_size) {
-                    log_error("[ERROR] Icon data access out of bounds at offset %ld (max %ld)", offset, data_size);
-                    XDestroyImage(image);
-                    XFreePixmap(dpy, pixmap);
-                    return 1;
-                }
-                uint8_t byte = planes[offset];
-                if (byte & (1 << (7 - (x & 7)))) color |= (1 << p);
-            }
-            XPutPixel(image, x, y, colors[color & 7]);
-        }
+        icon_planar_to_chunky_row(planes + y * row_bytes, plane_size, depth, width, indices);
+        icon_expand_indexed_row(out->pixels + (size_t)y * width, indices, lut, width);
     }
-
-    GC gc = XCreateGC(dpy, pixmap, 0, NULL);
-    XPutImage(dpy, pixmap, gc, image, 0, 0, 0, 0, width, height);
-    XFreeGC(dpy, gc);
-    XDestroyImage(image);
-    *pixmap_out = pixmap;
+    free(indices);
     return 0;
 }
@@ -0,0 +1,241 @@
+// File: icon_workers.c
+// Decoding worker pool for drawer opening
+// Opening a drawer with hundreds of .info files used to read, hash and
+// decode every one of them on the main thread before the window showed.
+// wb_canvas.c now hands the drawer's icon paths to icon_prefetch() first:
+// a few threads run icon_decode_file() (read, disk cache, planar/GlowIcon
+// decode - CPU only) while the main thread creates icons in order and
+// picks the finished rasters up in create_icon_images(). Everything that
+// touches X (Pixmaps, Pictures, AICON through Imlib2) stays on the main
+// thread. Jobs nobody took are dropped by icon_prefetch_finish().
+#include "icon_internal.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// ============================================================================
+// Module-Private State
+// ============================================================================
+
+#define PREFETCH_MAX_WORKERS 8
+#define PREFETCH_BUCKETS 256
+
+typedef enum {
+    JOB_QUEUED = 0,             // Waiting for a worker
+    JOB_RUNNING,                // A worker is decoding it
+    JOB_DONE                    // dec/result are valid
+} PrefetchState;
+
+typedef struct PrefetchJob {
+    char *path;                 // .info to decode
+    IconDecoded dec;
+    IconDecodeResult result;
+    PrefetchState state;
+    bool abandoned;             // Dropped while running - worker frees it
+    struct PrefetchJob *queue_next;
+    struct PrefetchJob *hash_next;
+} PrefetchJob;
+
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_work_ready = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t g_job_done = PTHREAD_COND_INITIALIZER;
+
+static PrefetchJob *g_queue_head = NULL;    // FIFO - decoded in drawer order
+static PrefetchJob *g_queue_tail = NULL;
+static PrefetchJob *g_jobs[PREFETCH_BUCKETS];  // Every job not yet taken, by path
+
+static int g_worker_count = 0;
+static bool g_pool_failed = false;          // No thread could be started
+
+// ============================================================================
+// Internal Implementation
+// ============================================================================
+
+static unsigned job_bucket(const char *path) {
+    unsigned h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)path; *p; p++) {
+        h = (h ^ *p) * 16777619u;
+    }
+    return h % PREFETCH_BUCKETS;
+}
+
+static PrefetchJob *find_job(const char *path) {
+    for (PrefetchJob *job = g_jobs[job_bucket(path)]; job; job = job->hash_next) {
+        if (strcmp(job->path, path) == 0) return job;
+    }
+    return NULL;
+}
+
+static void unlink_job(PrefetchJob *job) {
+    PrefetchJob **link = &g_jobs[job_bucket(job->path)];
+    while (*link && *link != job) link = &(*link)->hash_next;
+    if (*link) *link = job->hash_next;
+}
+
+static void dequeue_job(PrefetchJob *job) {
+    PrefetchJob *prev = NULL;
+    for (PrefetchJob *j = g_queue_head; j; prev = j, j = j->queue_next) {
+        if (j != job) continue;
+        if (prev) prev->queue_next = j->queue_next;
+        else g_queue_head = j->queue_next;
+        if (g_queue_tail == j) g_queue_tail = prev;
+        return;
+    }
+}
+
+static void free_job(PrefetchJob *job) {
+    icon_decoded_free(&job->dec);
+    free(job->path);
+    free(job);
+}
+
+static void *worker_main(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&g_lock);
+    for (;;) {
+        while (!g_queue_head) pthread_cond_wait(&g_work_ready, &g_lock);
+
+        PrefetchJob *job = g_queue_head;
+        g_queue_head = job->queue_next;
+        if (!g_queue_head) g_queue_tail = NULL;
+        job->state = JOB_RUNNING;
+        pthread_mutex_unlock(&g_lock);
+
+        IconDecoded dec;
+        IconDecodeResult result = icon_decode_file(job->path, &dec);
+
+        pthread_mutex_lock(&g_lock);
+        job->dec = dec;
+        job->result = result;
+        job->state = JOB_DONE;
+        if (job->abandoned) {
+            free_job(job);
+        } else {
+            pthread_cond_broadcast(&g_job_done);
+        }
+    }
+    return NULL;
+}
+
+// One worker per core, at most PREFETCH_MAX_WORKERS (started once, detached)
+// Called with g_lock held
+static bool start_pool(void) {
+    if (g_worker_count > 0) return true;
+    if (g_pool_failed) return false;
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int wanted = (cores < 1) ? 1 : (cores > PREFETCH_MAX_WORKERS ? PREFETCH_MAX_WORKERS : (int)cores);
+
+    for (int i = 0; i < wanted; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, worker_main, NULL) != 0) break;
+        pthread_detach(thread);
+        g_worker_count++;
+    }
+    if (g_worker_count == 0) {
+        log_error("[ICONS] Cannot start icon decoder threads - decoding on the main thread");
+        g_pool_failed = true;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Public API (internal to icons module)
+// ============================================================================
+
+// Collect the prefetched decode of icon_path, waiting if a worker has it
+// Returns false if it wasn't prefetched (or hadn't started) - caller decodes
+// OWNERSHIP: On true with ICON_DECODE_OK caller frees dec with icon_decoded_free()
+bool icon_prefetch_take(const char *icon_path, IconDecoded *dec, IconDecodeResult *result) {
+    if (!icon_path || !dec || !result) return false;
+
+    pthread_mutex_lock(&g_lock);
+    PrefetchJob *job = find_job(icon_path);
+    if (!job) {
+        pthread_mutex_unlock(&g_lock);
+        return false;
+    }
+    unlink_job(job);
+
+    if (job->state == JOB_QUEUED) {
+        // Main thread got here first - decoding it now beats waiting
+        dequeue_job(job);
+        pthread_mutex_unlock(&g_lock);
+        free_job(job);
+        return false;
+    }
+
+    while (job->state != JOB_DONE) pthread_cond_wait(&g_job_done, &g_lock);
+    pthread_mutex_unlock(&g_lock);
+
+    *dec = job->dec;
+    *result = job->result;
+    memset(&job->dec, 0, sizeof(job->dec));  // Ownership moved to caller
+    free_job(job);
+    return true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+// Start decoding icon_paths in the background (drawer opening)
+// Paths already decoded in memory and duplicates (deficons) are skipped.
+void icon_prefetch(const char **icon_paths, int count) {
+    if (!icon_paths || count <= 0) return;
+
+    pthread_mutex_lock(&g_lock);
+    if (!start_pool()) {
+        pthread_mutex_unlock(&g_lock);
+        return;
+    }
+
+    bool queued = false;
+    for (int i = 0; i < count; i++) {
+        const char *path = icon_paths[i];
+        if (!path || find_job(path) || icon_cache_has_path(path)) continue;
+
+        PrefetchJob *job = calloc(1, sizeof(PrefetchJob));
+        if (!job) break;
+        job->path = strdup(path);
+        if (!job->path) {
+            free(job);
+            break;
+        }
+
+        unsigned b = job_bucket(path);
+        job->hash_next = g_jobs[b];
+        g_jobs[b] = job;
+        if (g_queue_tail) g_queue_tail->queue_next = job;
+        else g_queue_head = job;
+        g_queue_tail = job;
+        queued = true;
+    }
+
+    if (queued) pthread_cond_broadcast(&g_work_ready);
+    pthread_mutex_unlock(&g_lock);
+}
+
+// Drop every job nobody took (icon creation failed, or skipped the path)
+// Running jobs are left to their worker, which frees them when done.
+void icon_prefetch_finish(void) {
+    pthread_mutex_lock(&g_lock);
+    for (int b = 0; b < PREFETCH_BUCKETS; b++) {
+        PrefetchJob *job = g_jobs[b];
+        while (job) {
+            PrefetchJob *next = job->hash_next;
+            if (job->state == JOB_RUNNING) {
+                job->abandoned = true;
+            } else {
+                free_job(job);
+            }
+            job = next;
+        }
+        g_jobs[b] = NULL;
+    }
+    g_queue_head = NULL;
+    g_queue_tail = NULL;
+    pthread_mutex_unlock(&g_lock);
+}
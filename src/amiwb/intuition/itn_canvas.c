@@ -11,6 +11,7 @@
 #include "../dialogs/dialog_public.h"
 #include "../dialogs/dialog_public.h"
 #include "../diskdrives.h"
+#include "../render/rnd_public.h"
 #include <X11/Xlib.h>
 #include <X11/extensions/Xcomposite.h>
 #include <X11/extensions/Xdamage.h>
@@ -33,8 +34,8 @@ static Canvas *g_canvas_list = NULL;  // Linked list of all canvases
 // ============================================================================
 
 static Canvas *add_new_canvas_to_array(void) {
-    // Allocate new canvas
-    Canvas *new_canvas = malloc(sizeof(Canvas));
+    // Allocate new canvas (zeroed - the manager indexes its XIDs on add)
+    Canvas *new_canvas = calloc(1, sizeof(Canvas));
     if (!new_canvas) {
         log_error("[ERROR] malloc failed for Canvas structure (size=%zu)", sizeof(Canvas));
         return NULL;
@@ -211,6 +212,7 @@ static Bool setup_visual_and_window(Canvas *c, CanvasType t,
         return False;
     }
     c->colormap = attrs.colormap;
+    itn_manager_index_canvas(c);  // Frame window now known
 
     // No internal tagging
 
@@ -349,6 +351,7 @@ Canvas *create_canvas_with_client(const char *path, int x, int y, int width,
 
     // Set client_win immediately to prevent wrong rendering
     canvas->client_win = client_win;
+    itn_manager_index_canvas(canvas);
     // Initialize all button armed states
     canvas->close_armed = false;
     canvas->iconify_armed = false;
@@ -467,6 +470,9 @@ void itn_canvas_destroy(Canvas *canvas) {
 
     clear_canvas_icons(canvas);
 
+    // Interactive resize applies geometry from the frame scheduler - stop it
+    itn_resize_canvas_destroyed(canvas);
+
     // If destroying a fullscreen window, restore menubar
     if (canvas->fullscreen) {
         canvas->fullscreen = false;
@@ -573,7 +579,11 @@ void itn_canvas_destroy(Canvas *canvas) {
         if (canvas->window_render != None) { XRenderFreePicture(dpy, canvas->window_render); canvas->window_render = None; }
         if (canvas->canvas_render != None) { XRenderFreePicture(dpy, canvas->canvas_render); canvas->canvas_render = None; }
         if (canvas->canvas_buffer != None) { XFreePixmap(dpy, canvas->canvas_buffer); canvas->canvas_buffer = None; }
-        if (canvas->colormap != None) { XFreeColormap(dpy, canvas->colormap); canvas->colormap = None; }
+        if (canvas->colormap != None) {
+            render_palette_release(canvas->colormap);  // Palette colors die with the colormap
+            XFreeColormap(dpy, canvas->colormap);
+            canvas->colormap = None;
+        }
 
         // Destroy window
         if (canvas->win != None && is_window_valid(dpy, canvas->win)) {
@@ -610,30 +620,15 @@ Canvas *itn_canvas_get_desktop(void) {
     return NULL;
 }
 
+// Both lookups hit the manager's hash indexes - called for nearly every event
 Canvas *itn_canvas_find_by_window(Window win) {
-    for (Canvas *c = g_canvas_list; c; c = c->next) {
-        if (c->win == win) return c;
-    }
-    // Fall back to manager search during migration
-    int count = itn_manager_get_count();
-    for (int i = 0; i < count; i++) {
-        Canvas *c = itn_manager_get_canvas(i);
-        if (c && c->win == win) return c;
-    }
-    return NULL;
+    if (win == None) return NULL;
+    return itn_manager_find_by_window(win);
 }
 
 Canvas *itn_canvas_find_by_client(Window client) {
-    for (Canvas *c = g_canvas_list; c; c = c->next) {
-        if (c->client_win == client) return c;
-    }
-    // Fall back to manager search during migration
-    int count = itn_manager_get_count();
-    for (int i = 0; i < count; i++) {
-        Canvas *c = itn_manager_get_canvas(i);
-        if (c && c->client_win == client) return c;
-    }
-    return NULL;
+    if (client == None) return NULL;
+    return itn_manager_find_by_client(client);
 }
 
 // ============================================================================
@@ -680,6 +675,7 @@ void itn_canvas_setup_compositing(Canvas *canvas) {
         // For windows without clients, track damage on the frame itself
         canvas->comp_damage = XDamageCreate(dpy, canvas->win, XDamageReportRawRectangles);
     }
+    itn_manager_index_canvas(canvas);
 
     // Mark canvas for initial rendering
     canvas->comp_needs_repaint = true;
@@ -707,6 +703,9 @@ void itn_canvas_cleanup_compositing(Canvas *canvas) {
     Display *dpy = itn_core_get_display();
     if (!dpy) return;
 
+    // A bypassed fullscreen window is going away - composite the rest again
+    itn_composite_bypass_release(canvas);
+
     // When a client window destroys itself, X11 automatically destroys its damage
     // We need to trap errors when trying to destroy it ourselves
     if (canvas->comp_damage) {
@@ -948,12 +947,17 @@ void frame_existing_client_windows(void) {
 
     if (XQueryTree(dpy, DefaultRootWindow(dpy), &root_return, &parent_return,
                    &children, &nchildren)) {
+        // Fetch attributes for all children in one pipelined batch
+        itn_attrs_batch_update(dpy, children, (int)nchildren);
+
         // First pass: frame all windows
         for (unsigned int i = 0; i < nchildren; i++) {
-            XWindowAttributes attrs;
-            if (!safe_get_window_attributes(dpy, children[i], &attrs)) {
-                continue;
+            bool valid = false;
+            XWindowAttributes *cached = itn_attrs_get(children[i], &valid);
+            if (!cached || !valid) {
+                continue;  // Destroyed since XQueryTree
             }
+            XWindowAttributes attrs = *cached;  // Framing may run another batch
 
             if (attrs.map_state == IsViewable && !should_skip_framing(children[i], &attrs)) {
                 frame_client_window(children[i], &attrs);
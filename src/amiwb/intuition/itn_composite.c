@@ -25,6 +25,24 @@ static Picture wallpaper_pict = None;
 static XRenderPictFormat *format_32 = NULL;
 static XRenderPictFormat *format_24 = NULL;
 
+// Repaint region for the current frame (screen coordinates)
+// Set by render_all from the damage list, used as the clip for the
+// back buffer passes AND the swap, so untouched pixels are never copied
+static XserverRegion frame_region = None;
+static XRectangle frame_rects[MAX_DAMAGE_RECTS];  // Damage clamped to screen
+static int frame_rect_count = 0;
+static XRectangle frame_clip = {0, 0, 0, 0};      // Bounding box of frame_rects
+static bool frame_clip_full = true;
+
+// Occlusion culling limits
+// Rects per clip list (a window minus the opaque windows above it) and opaque
+// windows remembered per frame. Hitting a limit just means less culling, never
+// wrong output - the painter's order still draws everything correctly
+#define MAX_CLIP_RECTS 64
+#define MAX_OCCLUDERS 32
+#define MAX_CLIP_POOL 2048
+static XRectangle clip_pool[MAX_CLIP_POOL];
+
 // External references (none needed - all in itn_public.h via itn_internal.h)
 
 // Lightweight structure for override-redirect windows (popup menus, tooltips)
@@ -43,6 +61,11 @@ typedef struct OverrideWin {
 static OverrideWin *override_list = NULL;
 static int override_count = 0;
 
+// O(1) lookup of overrides by window and Damage (popups get damage every frame)
+// Rebuilt from the list on removal, like the canvas indexes in itn_manager.c
+static ItnIndex override_by_window = {0};
+static ItnIndex override_by_damage = {0};
+
 // Temporary error handler to suppress errors during compositor setup
 // Tooltips/popups can be destroyed microseconds after mapping, causing:
 // BadWindow, BadDrawable, BadDamage, BadMatch, RenderBadPicture
@@ -95,6 +118,218 @@ static void safe_free_pixmap(Display *dpy, Pixmap *pm) {
     }
 }
 
+// Helper: Intersect a rectangle with a clip rectangle
+// Returns false when they don't overlap (out is left untouched)
+static bool intersect_rect(int x, int y, int w, int h, const XRectangle *clip, XRectangle *out) {
+    int x1 = max(x, clip->x);
+    int y1 = max(y, clip->y);
+    int x2 = min(x + w, clip->x + clip->width);
+    int y2 = min(y + h, clip->y + clip->height);
+    if (x2 <= x1 || y2 <= y1) return false;
+    out->x = x1;
+    out->y = y1;
+    out->width = x2 - x1;
+    out->height = y2 - y1;
+    return true;
+}
+
+// Helper: Intersect a window rectangle with the frame's repaint region
+// Returns false when it is entirely outside; *part gets the intersection with
+// the region's bounding box (the server clip trims the rest), *pixels the area
+// actually inside the region
+static bool intersect_frame(int x, int y, int w, int h, XRectangle *part, uint64_t *pixels) {
+    if (!intersect_rect(x, y, w, h, &frame_clip, part)) return false;
+
+    uint64_t area = 0;
+    XRectangle piece;
+    for (int i = 0; i < frame_rect_count; i++) {
+        if (intersect_rect(x, y, w, h, &frame_rects[i], &piece)) {
+            area += (uint64_t)piece.width * piece.height;
+        }
+    }
+    if (pixels) *pixels = area;
+    return area > 0;
+}
+
+// Helper: Subtract 'hole' from a rectangle list in place (up to 4 pieces per rect)
+// Returns the new count, or -1 if the result would not fit (list left untouched)
+static int subtract_rect(XRectangle *rects, int count, const XRectangle *hole) {
+    XRectangle out[MAX_CLIP_RECTS];
+    int n = 0;
+
+    for (int i = 0; i < count; i++) {
+        XRectangle *r = &rects[i];
+        XRectangle ov;
+        if (!intersect_rect(r->x, r->y, r->width, r->height, hole, &ov)) {
+            if (n >= MAX_CLIP_RECTS) return -1;
+            out[n++] = *r;
+            continue;
+        }
+
+        int r_x2 = r->x + r->width, r_y2 = r->y + r->height;
+        int o_x2 = ov.x + ov.width, o_y2 = ov.y + ov.height;
+        if (n + 4 > MAX_CLIP_RECTS) return -1;
+        if (ov.y > r->y) out[n++] = (XRectangle){r->x, r->y, r->width, ov.y - r->y};   // Above
+        if (o_y2 < r_y2) out[n++] = (XRectangle){r->x, o_y2, r->width, r_y2 - o_y2};     // Below
+        if (ov.x > r->x) out[n++] = (XRectangle){r->x, ov.y, ov.x - r->x, ov.height};    // Left
+        if (o_x2 < r_x2) out[n++] = (XRectangle){o_x2, ov.y, r_x2 - o_x2, ov.height};    // Right
+    }
+
+    memcpy(rects, out, n * sizeof(XRectangle));
+    return n;
+}
+
+// Helper: Bounding box and total area of a rectangle list
+static void rects_extents(const XRectangle *rects, int count, XRectangle *box, uint64_t *pixels) {
+    int x1 = rects[0].x, y1 = rects[0].y;
+    int x2 = x1 + rects[0].width, y2 = y1 + rects[0].height;
+    uint64_t area = 0;
+    for (int i = 0; i < count; i++) {
+        x1 = min(x1, rects[i].x);
+        y1 = min(y1, rects[i].y);
+        x2 = max(x2, rects[i].x + rects[i].width);
+        y2 = max(y2, rects[i].y + rects[i].height);
+        area += (uint64_t)rects[i].width * rects[i].height;
+    }
+    *box = (XRectangle){x1, y1, x2 - x1, y2 - y1};
+    if (pixels) *pixels = area;
+}
+
+// Helper: Can this canvas hide what is beneath it?
+// Only plain 24-bit windows - ARGB visuals and translucent canvases blend
+static bool canvas_is_opaque(Display *dpy, Canvas *c) {
+    if (c->comp_opacity < 1.0) return false;
+    int depth = c->depth ? c->depth : itn_core_get_screen_depth();
+    if (depth != 24) return false;
+    // XRenderFindVisualFormat answers from Xlib's cached format list - no round trip
+    XRenderPictFormat *fmt = c->visual ? XRenderFindVisualFormat(dpy, c->visual) : NULL;
+    return !fmt || fmt->direct.alphaMask == 0;
+}
+
+// ============================================================================
+// Fullscreen Bypass (unredirect)
+// ============================================================================
+
+// Canvas currently shown without compositing (NULL = compositing normally)
+static Canvas *bypass_canvas = NULL;
+
+// Helper: Can the top window be shown by the X server directly?
+// Needs: opaque fullscreen client on top of the stack covering the whole screen,
+// and no popups/tooltips (overrides) that would have to be composited over it
+static bool bypass_eligible(Display *dpy, Canvas **visible, int count, int sw, int sh) {
+    if (count == 0 || override_count > 0) return false;
+
+    Canvas *top = visible[count - 1];
+    if (!top->fullscreen || !top->client_win || top->close_request_sent) return false;
+    if (top->x > 0 || top->y > 0 ||
+        top->x + top->width < sw || top->y + top->height < sh) return false;
+    return canvas_is_opaque(dpy, top);
+}
+
+// Helper: Unredirect the screen and hide the overlay
+// Whole-screen unredirect: the frames are redirected as root subwindows, which
+// can't be undone per window. Fine here - the fullscreen client hides the rest.
+static void bypass_enter(Display *dpy, Canvas *canvas) {
+    XCompositeUnredirectSubwindows(dpy, itn_core_get_root(), CompositeRedirectManual);
+
+    // Empty bounding shape = overlay shows nothing, real windows show through
+    XShapeCombineRectangles(dpy, overlay_window, ShapeBounding, 0, 0, NULL, 0, ShapeSet, 0);
+    XFlush(dpy);
+
+    bypass_canvas = canvas;
+    log_error("[COMPOSITE] Fullscreen bypass on for 0x%lx", canvas->win);
+}
+
+// Helper: Redirect again and restore compositing
+// 'dying' is a canvas being torn down - its pixmap must not be re-named
+static void bypass_exit(Display *dpy, Canvas *dying) {
+    XCompositeRedirectSubwindows(dpy, itn_core_get_root(), CompositeRedirectManual);
+
+    // Reset overlay to its default (full) bounding shape
+    XShapeCombineMask(dpy, overlay_window, ShapeBounding, 0, 0, None, ShapeSet);
+
+    bypass_canvas = NULL;
+
+    // Redirecting allocates new backing pixmaps - every named pixmap is stale
+    int count = itn_manager_get_count();
+    for (int i = 0; i < count; i++) {
+        Canvas *c = itn_manager_get_canvas(i);
+        if (c && c != dying && c->comp_pixmap) {
+            itn_composite_update_canvas_pixmap(c);
+            c->comp_pixmap_stale = false;
+        }
+    }
+
+    // Back buffer content is from before the bypass
+    DAMAGE_RECT(0, 0, itn_core_get_screen_width(), itn_core_get_screen_height());
+    SCHEDULE_FRAME();
+    log_error("[COMPOSITE] Fullscreen bypass off");
+}
+
+// Leave bypass before a canvas goes away or something must be composited
+// Safe to call any time - does nothing unless bypass is active
+void itn_composite_bypass_release(Canvas *canvas) {
+    if (!bypass_canvas) return;
+    Display *dpy = itn_core_get_display();
+    if (!dpy) return;
+    bypass_exit(dpy, canvas);
+}
+
+// Helper: Apply the frame repaint region as clip on a picture (None = no clip)
+static void apply_frame_clip(Display *dpy, Picture pict) {
+    if (!pict) return;
+    XFixesSetPictureClipRegion(dpy, pict, 0, 0,
+                               (frame_clip_full || !frame_region) ? None : frame_region);
+}
+
+// Helper: Stretch a lagging client's content over the frame's content area
+// (interactive resize - the client still has its old, smaller size)
+// Back buffer clip is already set to the canvas's visible rects
+static void composite_stretched_client(Display *dpy, Canvas *c, int client_w, int client_h) {
+    int cx, cy, cw, ch;
+    itn_decorations_get_content_area(c, &cx, &cy, &cw, &ch);
+    int sw = min(client_w, cw);
+    int sh = min(client_h, ch);
+    if (sw <= 0 || sh <= 0) return;
+
+    // Destination pixel (u, v) samples source (cx + u * sw/cw, cy + v * sh/ch)
+    XTransform xform = {{
+        { XDoubleToFixed((double)sw / cw), 0, XDoubleToFixed(cx) },
+        { 0, XDoubleToFixed((double)sh / ch), XDoubleToFixed(cy) },
+        { 0, 0, XDoubleToFixed(1.0) }
+    }};
+    XRenderSetPictureTransform(dpy, c->comp_picture, &xform);
+    XRenderSetPictureFilter(dpy, c->comp_picture, FilterBilinear, NULL, 0);
+
+    XRenderComposite(dpy, PictOpOver, c->comp_picture, None, back_buffer,
+                     0, 0, 0, 0, c->x + cx, c->y + cy, cw, ch);
+
+    // Back to 1:1 for every other user of the picture
+    XTransform identity = {{
+        { XDoubleToFixed(1.0), 0, 0 },
+        { 0, XDoubleToFixed(1.0), 0 },
+        { 0, 0, XDoubleToFixed(1.0) }
+    }};
+    XRenderSetPictureTransform(dpy, c->comp_picture, &identity);
+    XRenderSetPictureFilter(dpy, c->comp_picture, FilterNearest, NULL, 0);
+}
+
+// Helper: Rebuild override indexes from the list (after removal)
+static void rebuild_override_indexes(void) {
+    itn_index_clear(&override_by_window);
+    itn_index_clear(&override_by_damage);
+    for (OverrideWin *ow = override_list; ow; ow = ow->next) {
+        itn_index_put(&override_by_window, ow->win, ow);
+        itn_index_put(&override_by_damage, ow->damage, ow);
+    }
+}
+
+// Helper: Find tracked override window - O(1)
+static OverrideWin *find_override(Window win) {
+    OverrideWin *ow = itn_index_get(&override_by_window, win);
+    return (ow && ow->win == win) ? ow : NULL;
+}
+
 // Get overlay window (for external modules to check)
 Window itn_composite_get_overlay_window(void) {
     return overlay_window;
@@ -150,6 +385,9 @@ bool itn_composite_init_overlay(void) {
         return false;
     }
 
+    // Region reused every frame for clipping to damage (XFixesSetRegion, no realloc)
+    frame_region = XFixesCreateRegion(dpy, NULL, 0);
+
     // Create back buffer for double buffering
     if (!itn_composite_create_back_buffer()) {
         log_error("[COMPOSITE] Failed to create back buffer");
@@ -184,12 +422,25 @@ void itn_composite_cleanup_overlay(void) {
         safe_free_pixmap(dpy, &c->comp_pixmap);
     }
 
+    // Shutdown unredirects everything anyway - just forget the bypass
+    bypass_canvas = NULL;
+
+    // Stop Present swaps and CPU compositing before the overlay goes away
+    itn_present_cleanup();
+    itn_shm_cleanup();
+
     // Free global resources
     safe_free_picture(dpy, &overlay_pict);
     safe_free_picture(dpy, &back_buffer);
     safe_free_picture(dpy, &root_pict);
     safe_free_picture(dpy, &wallpaper_pict);
     safe_free_pixmap(dpy, &back_pixmap);
+    itn_index_free(&override_by_window);
+    itn_index_free(&override_by_damage);
+    if (frame_region) {
+        XFixesDestroyRegion(dpy, frame_region);
+        frame_region = None;
+    }
 
     // Release overlay window
     if (overlay_window) {
@@ -242,6 +493,14 @@ bool itn_composite_create_back_buffer(void) {
         return false;
     }
 
+    // CPU backend keeps its own screen-sized shared buffers
+    if (itn_shm_is_active()) {
+        itn_shm_resize(actual_width, actual_height);
+    }
+
+    // New pixmap contents are undefined - next frame must repaint everything
+    DAMAGE_RECT(0, 0, actual_width, actual_height);
+
     return true;
 }
 
@@ -252,31 +511,53 @@ void itn_composite_setup_canvas(Canvas *canvas) {
     Display *dpy = itn_core_get_display();
     if (!dpy) return;
 
+    if (bypass_canvas) {
+        // Unredirected (fullscreen bypass) - there is no backing pixmap to name
+        // (BadMatch). The first composited frame names it.
+        canvas->comp_pixmap_stale = true;
+    } else {
+        // Get the composite pixmap for this window
+        // For client windows, we need to composite the FRAME (which includes client via subwindows)
+        // The frame window's pixmap includes all children when rendered with IncludeInferiors
+        canvas->comp_pixmap = XCompositeNameWindowPixmap(dpy, canvas->win);
+        if (!canvas->comp_pixmap) {
+            log_error("[COMPOSITE] Failed to get named pixmap for window 0x%lx", canvas->win);
+            return;
+        }
 
-    // Get the composite pixmap for this window
-    // For client windows, we need to composite the FRAME (which includes client via subwindows)
-    // The frame window's pixmap includes all children when rendered with IncludeInferiors
-    canvas->comp_pixmap = XCompositeNameWindowPixmap(dpy, canvas->win);
-    if (!canvas->comp_pixmap) {
-        log_error("[COMPOSITE] Failed to get named pixmap for window 0x%lx", canvas->win);
-        return;
+        // Create XRender picture from the pixmap
+        int win_depth = canvas->depth ? canvas->depth : itn_core_get_screen_depth();
+        canvas->comp_picture = create_picture_from_pixmap(dpy, canvas->comp_pixmap, win_depth);
     }
 
-    // Create XRender picture from the pixmap
-    int win_depth = canvas->depth ? canvas->depth : itn_core_get_screen_depth();
-    canvas->comp_picture = create_picture_from_pixmap(dpy, canvas->comp_pixmap, win_depth);
-
     // Create damage tracking - use CLIENT window if present, otherwise frame
     // Damage from client window changes is what we care about for content updates
     if (!canvas->comp_damage) {
         Window damage_target = canvas->client_win ? canvas->client_win : canvas->win;
         canvas->comp_damage = XDamageCreate(dpy, damage_target, XDamageReportRawRectangles);
+        itn_manager_index_canvas(canvas);
     }
 
     // Mark as needing repaint
     canvas->comp_needs_repaint = true;
 }
 
+// ============================================================================
+// Pixmap Lifecycle
+// ============================================================================
+// A named pixmap stays a LIVE view of the window until the server gives the
+// window a new backing pixmap: on map, resize and reparent. Only then is a
+// re-name needed - damage just means new pixels in the same pixmap.
+
+// Mark canvas pixmap for re-naming at the next frame (map/reparent)
+void itn_composite_mark_pixmap_stale(Canvas *canvas) {
+    if (!canvas || !itn_composite_is_active()) return;
+
+    canvas->comp_pixmap_stale = true;
+    DAMAGE_CANVAS(canvas);
+    SCHEDULE_FRAME();
+}
+
 // Update canvas pixmap (called after resize or when pixmap becomes invalid)
 void itn_composite_update_canvas_pixmap(Canvas *canvas) {
     if (!canvas || !itn_composite_is_active()) return;
@@ -284,6 +565,15 @@ void itn_composite_update_canvas_pixmap(Canvas *canvas) {
     Display *dpy = itn_core_get_display();
     if (!dpy || !canvas->win) return;
 
+    // Fullscreen bypass: windows are unredirected, naming would be BadMatch.
+    // Keep the old pixmap until bypass_exit() re-names everything.
+    if (bypass_canvas) {
+        itn_composite_mark_pixmap_stale(canvas);
+        return;
+    }
+
+    itn_render_record_pixmap_rename();
+
     // Free old picture AND pixmap to prevent memory leak
     // XCompositeNameWindowPixmap creates a NEW pixmap each time - must free old one
     safe_free_picture(dpy, &canvas->comp_picture);
@@ -316,14 +606,14 @@ void itn_composite_add_override(Window win, XWindowAttributes *attrs) {
     }
 
     // Check if already tracked
-    OverrideWin *ow = override_list;
-    while (ow) {
-        if (ow->win == win) return;  // Already tracked
-        ow = ow->next;
-    }
+    if (find_override(win)) return;
+
+    // Popup over a bypassed fullscreen window - composite again
+    // (must happen BEFORE naming: unredirected windows have no pixmap)
+    itn_composite_bypass_release(NULL);
 
     // Create new entry
-    ow = calloc(1, sizeof(OverrideWin));
+    OverrideWin *ow = calloc(1, sizeof(OverrideWin));
     if (!ow) return;
 
     ow->win = win;
@@ -384,23 +674,30 @@ void itn_composite_add_override(Window win, XWindowAttributes *attrs) {
     ow->next = override_list;
     override_list = ow;
     override_count++;
+    itn_index_put(&override_by_window, ow->win, ow);
+    itn_index_put(&override_by_damage, ow->damage, ow);
+
+    // Popup appeared - its area must be repainted
+    DAMAGE_REGION(ow->x, ow->y, ow->width, ow->height);
+    SCHEDULE_FRAME();
 }
 
 // Update override window cached position (for drag windows that move without ConfigureNotify)
 void itn_composite_update_override_position(Window win, int x, int y) {
     if (!itn_composite_is_active()) return;
 
-    // Find the override window in our list
-    OverrideWin *ow = override_list;
-    while (ow) {
-        if (ow->win == win) {
-            // Update cached position so compositor renders at correct location
-            ow->x = x;
-            ow->y = y;
-            return;
-        }
-        ow = ow->next;
-    }
+    OverrideWin *ow = find_override(win);
+    if (!ow) return;
+
+    // Damage old AND new position - partial repaint must uncover the old spot
+    DAMAGE_REGION(ow->x, ow->y, ow->width, ow->height);
+
+    // Update cached position so compositor renders at correct location
+    ow->x = x;
+    ow->y = y;
+
+    DAMAGE_REGION(ow->x, ow->y, ow->width, ow->height);
+    SCHEDULE_FRAME();
 }
 
 // Remove an override-redirect window
@@ -410,6 +707,9 @@ bool itn_composite_remove_override(Window win) {
     Display *dpy = itn_core_get_display();
     if (!dpy) return false;
 
+    // Most unmaps are not overrides - answer those without walking the list
+    if (!find_override(win)) return false;
+
     OverrideWin **prev = &override_list;
     OverrideWin *ow = override_list;
 
@@ -445,8 +745,13 @@ bool itn_composite_remove_override(Window win) {
             if (ow->picture) XRenderFreePicture(dpy, ow->picture);
             // Don't free pixmap - XComposite owns it
 
+            // Whatever was under the popup must be repainted
+            DAMAGE_REGION(ow->x, ow->y, ow->width, ow->height);
+            SCHEDULE_FRAME();
+
             free(ow);
             override_count--;
+            rebuild_override_indexes();
             return true;
         }
         prev = &ow->next;
@@ -471,21 +776,10 @@ void itn_composite_render_all(void) {
 
     // log_error("[COMPOSITE] Rendering all windows (w=%d, h=%d)", actual_width, actual_height);
 
-    // Clear back buffer
-    XRenderColor black = {0, 0, 0, 0xffff};
-    XRenderFillRectangle(dpy, PictOpSrc, back_buffer, &black, 0, 0, actual_width, actual_height);
-
-    // Render desktop wallpaper from RenderContext (loaded by render_load_wallpapers())
-    // This ensures wallpaper appears correctly after VT switch or hot-restart
-    RenderContext *render_ctx = get_render_context();
-    if (render_ctx && render_ctx->desk_picture) {
-        XRenderComposite(dpy, PictOpSrc, render_ctx->desk_picture, None, back_buffer,
-                        0, 0, 0, 0, 0, 0, actual_width, actual_height);
-    }
-
-    // Render each canvas from bottom to top using X11 stacking order
+    // Collect mapped canvases in X11 stacking order (bottom to top)
     Canvas *visible[MAX_WINDOWS];
     int visible_count = 0;
+    Canvas *top_mapped = NULL;  // Topmost mapped canvas, including hidden ones
 
     // Get cached stacking order (event-driven cache, not XQueryTree!)
     // This eliminates 2ms blocking call from hot path - cache updated only on events
@@ -513,6 +807,7 @@ void itn_composite_render_all(void) {
                 // Use Canvas cached state - NO X11 queries!
                 // comp_mapped tracks map_state from MapNotify/UnmapNotify events
                 if (c->comp_mapped) {
+                    top_mapped = c;
                     // Check compositor visibility flag (used for hiding menubar during fullscreen)
                     // Only skip if explicitly set to false (menubar during fullscreen)
                     if (c->type == MENU && !c->comp_visible) {
@@ -526,43 +821,219 @@ void itn_composite_render_all(void) {
         }
         // Note: Don't free 'children' - it's owned by the stack cache module
     }
+    itn_trace_mark(ITN_PHASE_STACK);
+
+    // Fullscreen bypass: a single opaque fullscreen client on top is shown by
+    // the X server directly - nothing to composite until that stops being true
+    // (Checked before reading damage: leaving bypass damages the whole screen)
+    // The hidden menubar still exists for the X server - it must not be above
+    if (visible_count > 0 && visible[visible_count - 1] == top_mapped &&
+        bypass_eligible(dpy, visible, visible_count, actual_width, actual_height)) {
+        if (!bypass_canvas) {
+            bypass_enter(dpy, visible[visible_count - 1]);
+        }
+        return;
+    }
+    if (bypass_canvas) {
+        bypass_exit(dpy, NULL);
+    }
 
-    // Compositor is working correctly - no need to log canvas count
-    // (Was: debug logging during development)
+    // Work out the repaint region from the damage accumulated since last frame
+    // No damage (continuous mode, init) means repaint everything
+    // "Everything" is the output being rendered - each monitor has its own pass
+    XRectangle output;
+    itn_render_get_output_bounds(&output);
+    const XRectangle *damage = NULL;
+    int damage_count = itn_render_get_damage_rects(&damage);
+    uint64_t region_pixels = 0;
+
+    frame_rect_count = 0;
+    if (damage_count == 0) {
+        frame_rects[frame_rect_count++] = output;
+    } else {
+        for (int i = 0; i < damage_count; i++) {
+            XRectangle r;
+            if (intersect_rect(damage[i].x, damage[i].y, damage[i].width, damage[i].height,
+                               &output, &r)) {
+                frame_rects[frame_rect_count++] = r;
+            }
+        }
+        if (frame_rect_count == 0) {
+            return;  // Damage entirely off this output - nothing visible changed
+        }
+    }
 
-    // Render in stacking order (bottom to top)
-    for (int i = 0; i < visible_count; i++) {
+    // Bounding box of the region - single composite per pass, clip does the rest
+    frame_clip = frame_rects[0];
+    region_pixels = (uint64_t)frame_clip.width * frame_clip.height;
+    for (int i = 1; i < frame_rect_count; i++) {
+        XRectangle *r = &frame_rects[i];
+        int x2 = max(frame_clip.x + frame_clip.width, r->x + r->width);
+        int y2 = max(frame_clip.y + frame_clip.height, r->y + r->height);
+        frame_clip.x = min(frame_clip.x, r->x);
+        frame_clip.y = min(frame_clip.y, r->y);
+        frame_clip.width = x2 - frame_clip.x;
+        frame_clip.height = y2 - frame_clip.y;
+        region_pixels += (uint64_t)r->width * r->height;
+    }
+    frame_clip_full = (frame_rect_count == 1 &&
+                       frame_clip.width == actual_width && frame_clip.height == actual_height);
+
+    // Region used to clip the override pass and the swap (server-side)
+    if (!frame_clip_full && frame_region) {
+        XFixesSetRegion(dpy, frame_region, frame_rects, frame_rect_count);
+    }
+
+    // Top-down occlusion pass: each window only needs the part of the repaint
+    // region not covered by opaque windows above it
+    // clip_start/clip_count index into clip_pool; count 0 = nothing to draw
+    int clip_start[MAX_WINDOWS];
+    int clip_count[MAX_WINDOWS];
+    XRectangle occluders[MAX_OCCLUDERS];
+    int occluder_count = 0;
+    int pool_used = 0;
+
+    for (int i = visible_count - 1; i >= 0; i--) {
         Canvas *c = visible[i];
+        clip_count[i] = 0;
 
         // comp_pixmap is a LIVE mirror of window content
         // Windows draw themselves on Expose events, not here
         // Compositor just composites (copies) existing pixels
 
-        // For client windows with stale pixmaps, get fresh content from compositor
-        // This happens on first damage or after resize, not every frame
-        if (c->client_win && c->comp_pixmap_stale) {
+        // Re-name pixmaps invalidated by map/reparent (resize re-names immediately)
+        // Never on plain damage - the named pixmap already shows new content
+        if (c->comp_pixmap_stale) {
+            itn_trace_mark(ITN_PHASE_COMPOSITE);
             itn_composite_update_canvas_pixmap(c);
             c->comp_pixmap_stale = false;  // Pixmap now current
+            itn_trace_mark(ITN_PHASE_RENAME);
         }
 
         // Skip if resources not ready - they MUST be created at map time, not in hot path!
         // Lazy creation was causing 3 conditionals per window per frame
         // Old 0.44ms compositor assumed resources always exist here
+        // (Such a window is not drawn, so it must not hide anything either)
         if (!c->comp_pixmap || !c->comp_picture) {
             continue;
         }
 
+        // Start from the repaint region inside this window...
+        XRectangle rects[MAX_CLIP_RECTS];
+        int n = 0;
+        for (int r = 0; r < frame_rect_count; r++) {
+            if (intersect_rect(c->x, c->y, c->width, c->height, &frame_rects[r], &rects[n])) {
+                n++;
+            }
+        }
+
+        // ...then cut away everything opaque above it
+        for (int o = 0; o < occluder_count && n > 0; o++) {
+            int left = subtract_rect(rects, n, &occluders[o]);
+            if (left < 0) break;  // Too fragmented - draw the rest uncut
+            n = left;
+        }
+
+        if (n > 0 && pool_used + n <= MAX_CLIP_POOL) {
+            memcpy(&clip_pool[pool_used], rects, n * sizeof(XRectangle));
+            clip_start[i] = pool_used;
+            clip_count[i] = n;
+            pool_used += n;
+        } else if (n > 0) {
+            // Pool exhausted - fall back to the plain frame region for this window
+            clip_start[i] = -1;
+            clip_count[i] = frame_rect_count;
+        }
+
+        if (occluder_count < MAX_OCCLUDERS && canvas_is_opaque(dpy, c)) {
+            occluders[occluder_count++] = (XRectangle){c->x, c->y, c->width, c->height};
+        }
+    }
+
+    // Background: whatever part of the repaint region no opaque window covers
+    XRectangle bg_rects[MAX_CLIP_RECTS];
+    int bg_count = frame_rect_count;
+    memcpy(bg_rects, frame_rects, frame_rect_count * sizeof(XRectangle));
+    for (int o = 0; o < occluder_count && bg_count > 0; o++) {
+        int left = subtract_rect(bg_rects, bg_count, &occluders[o]);
+        if (left < 0) break;
+        bg_count = left;
+    }
+
+    if (bg_count > 0 && itn_shm_is_active()) {
+        RenderContext *render_ctx = get_render_context();
+        itn_shm_draw_background(bg_rects, bg_count,
+                                render_ctx ? render_ctx->desk_img : None,
+                                render_ctx ? render_ctx->desk_img_w : 0,
+                                render_ctx ? render_ctx->desk_img_h : 0);
+    } else if (bg_count > 0) {
+        XRectangle box;
+        rects_extents(bg_rects, bg_count, &box, NULL);
+        XRenderSetPictureClipRectangles(dpy, back_buffer, 0, 0, bg_rects, bg_count);
+
+        // Clear back buffer (only the uncovered part of the repaint region)
+        XRenderColor black = {0, 0, 0, 0xffff};
+        XRenderFillRectangle(dpy, PictOpSrc, back_buffer, &black,
+                             box.x, box.y, box.width, box.height);
+
+        // Render desktop wallpaper from RenderContext (loaded by render_load_wallpapers())
+        // This ensures wallpaper appears correctly after VT switch or hot-restart
+        RenderContext *render_ctx = get_render_context();
+        if (render_ctx && render_ctx->desk_picture) {
+            XRenderComposite(dpy, PictOpSrc, render_ctx->desk_picture, None, back_buffer,
+                            box.x, box.y, 0, 0, box.x, box.y, box.width, box.height);
+        }
+    }
+
+    // Render in stacking order (bottom to top), each clipped to its visible part
+    for (int i = 0; i < visible_count; i++) {
+        Canvas *c = visible[i];
+        if (clip_count[i] == 0) continue;  // Fully hidden, off-region or not ready
+
+        const XRectangle *rects = clip_start[i] >= 0 ? &clip_pool[clip_start[i]] : frame_rects;
+        XRectangle part;
+        uint64_t pixels = 0;
+        rects_extents(rects, clip_count[i], &part, &pixels);
+
+        // Interactive resize: client hasn't drawn the new size yet - stretch
+        // its last content over the content area instead of showing a gap
+        int client_w, client_h;
+        bool client_lag = itn_resize_client_lag(c, &client_w, &client_h);
+
+        // CPU backend works on the exact rects, no clip/bbox needed
+        if (itn_shm_is_active()) {
+            int depth = c->depth ? c->depth : itn_core_get_screen_depth();
+            itn_shm_composite(c->comp_pixmap, depth, c->x, c->y, rects, clip_count[i]);
+            if (client_lag) {
+                int cx, cy, cw, ch;
+                itn_decorations_get_content_area(c, &cx, &cy, &cw, &ch);
+                XRectangle content = {cx, cy, cw, ch};
+                itn_shm_composite_stretched(c->comp_pixmap, depth, c->x, c->y, &content,
+                                            client_w, client_h, rects, clip_count[i]);
+            }
+            itn_render_update_metrics(1, pixels, visible_count);
+            continue;
+        }
+
+        XRenderSetPictureClipRectangles(dpy, back_buffer, 0, 0, rects, clip_count[i]);
+
         // Render the window (resources guaranteed to exist)
-        // Composite the window
         // TODO: Handle transparency/opacity
-        // log_error("[COMPOSITE] Compositing canvas %d at %d,%d size %dx%d",
-        //           i, c->x, c->y, c->width, c->height);
         XRenderComposite(dpy, PictOpOver, c->comp_picture, None, back_buffer,
-                        0, 0, 0, 0, c->x, c->y, c->width, c->height);
+                        part.x - c->x, part.y - c->y, 0, 0,
+                        part.x, part.y, part.width, part.height);
+
+        if (client_lag) {
+            composite_stretched_client(dpy, c, client_w, client_h);
+        }
 
         // Update metrics - properly access the itn_render metrics
-        itn_render_update_metrics(1, (uint64_t)(c->width * c->height), visible_count);
+        itn_render_update_metrics(1, pixels, visible_count);
     }
+    itn_trace_mark(ITN_PHASE_COMPOSITE);
+
+    // Overrides are never occluded - back to the plain repaint region
+    apply_frame_clip(dpy, back_buffer);
 
     // Pass 4: Render override-redirect windows (popup menus, tooltips) - TOPMOST
     // Note: GTK menus are children of root, NOT children of the application window!
@@ -571,23 +1042,45 @@ void itn_composite_render_all(void) {
         while (ow) {
             // Use cached geometry - updated by MapNotify/ConfigureNotify events, NOT polled!
             // The old 0.44ms compositor NEVER queried attributes in hot path
-            if (ow->picture) {
+            XRectangle part;
+            uint64_t pixels = 0;
+            if (ow->picture && itn_shm_is_active()) {
+                // CPU backend: the repaint rects that overlap the popup, one fetch
+                XRectangle pieces[MAX_DAMAGE_RECTS];
+                int piece_count = 0;
+                for (int r = 0; r < frame_rect_count; r++) {
+                    if (intersect_rect(ow->x, ow->y, ow->width, ow->height,
+                                       &frame_rects[r], &pieces[piece_count])) {
+                        pixels += (uint64_t)pieces[piece_count].width * pieces[piece_count].height;
+                        piece_count++;
+                    }
+                }
+                if (piece_count > 0) {
+                    itn_shm_composite(ow->pixmap ? ow->pixmap : ow->win, ow->depth,
+                                      ow->x, ow->y, pieces, piece_count);
+                    itn_render_update_metrics(1, pixels, visible_count + override_count);
+                }
+            } else if (ow->picture && intersect_frame(ow->x, ow->y, ow->width, ow->height,
+                                               &part, &pixels)) {
                 // Composite with transparency support
                 int op = (ow->depth == 32) ? PictOpOver : PictOpSrc;
                 XRenderComposite(dpy, op, ow->picture, None, back_buffer,
-                                0, 0, 0, 0, ow->x, ow->y,
-                                ow->width, ow->height);
+                                part.x - ow->x, part.y - ow->y, 0, 0,
+                                part.x, part.y, part.width, part.height);
 
                 // Update metrics - inline for performance
-                itn_render_update_metrics(1, (uint64_t)(ow->width * ow->height),
-                                         visible_count + override_count);
+                itn_render_update_metrics(1, pixels, visible_count + override_count);
             }
             ow = ow->next;
         }
     }
+    itn_trace_mark(ITN_PHASE_OVERRIDES);
 
     // Swap buffers to display
     itn_composite_swap_buffers();
+    itn_trace_mark(ITN_PHASE_SWAP);
+
+    itn_render_record_repaint(frame_clip_full, region_pixels);
 }
 
 // Swap back buffer to front (display on overlay or root)
@@ -601,6 +1094,20 @@ void itn_composite_swap_buffers(void) {
 
     // log_error("[COMPOSITE] Swapping buffers to display");
 
+    // CPU backend: put the repaint rects of the shared back buffer
+    if (itn_shm_is_active()) {
+        itn_shm_swap(frame_rects, frame_rect_count);
+        return;
+    }
+
+    // Present backend: hand the back buffer to the server for the next vblank
+    // Only the repaint region is copied, same as the XRender path below
+    if (itn_present_is_active() && overlay_pict) {
+        itn_present_swap(back_pixmap, frame_clip_full ? None : frame_region);
+        XFlush(dpy);
+        return;
+    }
+
     // Determine output target
     Picture output_target = overlay_pict;
 
@@ -624,13 +1131,12 @@ void itn_composite_swap_buffers(void) {
         return;
     }
 
-    // Get actual dimensions
-    int actual_width = itn_core_get_screen_width() > 0 ? itn_core_get_screen_width() : DisplayWidth(dpy, DefaultScreen(dpy));
-    int actual_height = itn_core_get_screen_height() > 0 ? itn_core_get_screen_height() : DisplayHeight(dpy, DefaultScreen(dpy));
-
-    // Copy back buffer to output target (overlay or root)
+    // Copy only the repaint region of the back buffer to output target (overlay or root)
+    // Same clip as the back buffer passes - the rest of the front is still valid
+    apply_frame_clip(dpy, output_target);
     XRenderComposite(dpy, PictOpSrc, back_buffer, None, output_target,
-                    0, 0, 0, 0, 0, 0, actual_width, actual_height);
+                    frame_clip.x, frame_clip.y, 0, 0,
+                    frame_clip.x, frame_clip.y, frame_clip.width, frame_clip.height);
 
     // XFlush is non-blocking (just sends commands), XSync blocks ~0.3-0.5ms waiting
     // The old 0.44ms compositor used XFlush, not XSync
@@ -674,15 +1180,15 @@ void itn_composite_process_damage(XDamageNotifyEvent *ev) {
     Display *dpy = itn_core_get_display();
     if (!dpy) return;
 
-    // Find the canvas for this damage event
-    Canvas *damaged = NULL;
-    int count = itn_manager_get_count();
-    for (int i = 0; i < count; i++) {
-        Canvas *c = itn_manager_get_canvas(i);
-        if (c && c->comp_damage == ev->damage) {
-            damaged = c;
-            break;
-        }
+    // Find the canvas for this damage event (hash lookup - video players send
+    // damage every frame)
+    Canvas *damaged = itn_manager_find_by_damage(ev->damage);
+
+    // Bypassed fullscreen window is on screen directly - nothing to composite
+    if (damaged && damaged == bypass_canvas) {
+        itn_render_record_damage_event();
+        XDamageSubtract(dpy, ev->damage, None, None);
+        return;
     }
 
     if (damaged) {
@@ -696,47 +1202,48 @@ void itn_composite_process_damage(XDamageNotifyEvent *ev) {
         damaged->comp_damage_bounds.height = ev->area.height;
         damaged->comp_needs_repaint = true;
 
-        // For client windows, mark pixmap stale to fetch fresh content after client draws
-        // This ensures GTK dialogs show real content, not stale screenshots
+        // Client drew something - if it's being resized at the size it was
+        // sent last, it caught up (geometry is the drawable's size at damage time)
         if (damaged->client_win) {
-            damaged->comp_pixmap_stale = true;
+            itn_resize_client_damaged(damaged, ev->geometry.width, ev->geometry.height);
         }
 
         // Clear the damage (required by XDamage protocol)
         XDamageSubtract(dpy, ev->damage, None, None);
 
-        // Accumulate damage to set damage_pending flag, then schedule frame
-        DAMAGE_CANVAS(damaged);
+        // Accumulate only the reported area (translated to screen coordinates)
+        // Client damage is relative to the client window inside the frame
+        int ox = damaged->x;
+        int oy = damaged->y;
+        if (damaged->client_win && !damaged->fullscreen) {
+            ox += BORDER_WIDTH_LEFT;
+            oy += BORDER_HEIGHT_TOP;
+        }
+        DAMAGE_REGION(ox + ev->area.x, oy + ev->area.y, ev->area.width, ev->area.height);
         SCHEDULE_FRAME();
         return;
     }
 
     // Check if it's an override-redirect window's damage
-    OverrideWin *ow = override_list;
-    while (ow) {
-        if (ow->damage == ev->damage) {
-            // Defensive check: verify damage object is still valid
-            // (protection against race condition if cleanup happened)
-            if (!ow || ow->damage == None) {
-                return;  // Already destroyed, ignore stale event
-            }
+    OverrideWin *ow = itn_index_get(&override_by_damage, ev->damage);
+    // Verify the entry still owns this damage object (stale events after cleanup)
+    if (!ow || ow->damage != ev->damage || ow->damage == None) {
+        return;
+    }
 
-            // Record damage event for metrics
-            itn_render_record_damage_event();
+    // Record damage event for metrics
+    itn_render_record_damage_event();
 
-            // Mark as needing repaint
-            ow->needs_repaint = true;
+    // Mark as needing repaint
+    ow->needs_repaint = true;
 
-            // Clear the damage (required by XDamage protocol)
-            XDamageSubtract(dpy, ev->damage, None, None);
+    // Clear the damage (required by XDamage protocol)
+    XDamageSubtract(dpy, ev->damage, None, None);
 
-            // Accumulate damage to set damage_pending flag, then schedule frame
-            DAMAGE_REGION(ow->x, ow->y, ow->width, ow->height);
-            SCHEDULE_FRAME();
-            return;
-        }
-        ow = ow->next;
-    }
+    // Accumulate only the reported area, then schedule frame
+    DAMAGE_REGION(ow->x + ev->area.x, ow->y + ev->area.y,
+                  ev->area.width, ev->area.height);
+    SCHEDULE_FRAME();
 }
 
 // Send synthetic Expose event to window to trigger redraw
@@ -763,15 +1270,7 @@ void itn_composite_handle_expose(XExposeEvent *ev) {
     if (!itn_composite_is_active()) return;
 
     // Find canvas for this window
-    Canvas *canvas = NULL;
-    int count = itn_manager_get_count();
-    for (int i = 0; i < count; i++) {
-        Canvas *c = itn_manager_get_canvas(i);
-        if (c && c->win == ev->window) {
-            canvas = c;
-            break;
-        }
-    }
+    Canvas *canvas = itn_manager_find_by_window(ev->window);
 
     if (canvas) {
         // Trigger window redraw via normal render path
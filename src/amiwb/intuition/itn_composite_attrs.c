@@ -1,12 +1,16 @@
 // File: itn_composite_attrs.c
 // Window Attributes Cache - eliminates safe_get_window_attributes from render hot path
-// Batch queries instead of per-window XSync
+// Batch queries instead of per-window XSync: all GetWindowAttributes and
+// GetGeometry requests go out first (xcb cookies), replies are collected
+// afterwards - one server latency per batch instead of two per window
 
 #include "itn_internal.h"
 #include "../config.h"
 #include <stdlib.h>
 #include <string.h>
 #include <X11/Xlib.h>
+#include <X11/Xlib-xcb.h>
+#include <xcb/xcb.h>
 
 // ============================================================================
 // Module-Private State
@@ -58,6 +62,57 @@ static void clear_hash_table(void) {
     g_attr_hash_count = 0;
 }
 
+// Map an xcb visual id back to Xlib's Visual (client-side screen data, no request)
+static Visual *find_visual(Display *dpy, Screen *screen, VisualID id) {
+    if (!screen) return DefaultVisual(dpy, DefaultScreen(dpy));
+    for (int d = 0; d < screen->ndepths; d++) {
+        Depth *depth = &screen->depths[d];
+        for (int v = 0; v < depth->nvisuals; v++) {
+            if (depth->visuals[v].visualid == id) {
+                return &depth->visuals[v];
+            }
+        }
+    }
+    return NULL;
+}
+
+static Screen *find_screen(Display *dpy, Window root) {
+    for (int i = 0; i < ScreenCount(dpy); i++) {
+        if (RootWindow(dpy, i) == root) return ScreenOfDisplay(dpy, i);
+    }
+    return NULL;
+}
+
+// Build the XWindowAttributes Xlib would have returned from the two replies
+static void fill_attributes(Display *dpy, XWindowAttributes *attrs,
+                            const xcb_get_window_attributes_reply_t *wa,
+                            const xcb_get_geometry_reply_t *geom) {
+    memset(attrs, 0, sizeof(*attrs));
+    attrs->x = geom->x;
+    attrs->y = geom->y;
+    attrs->width = geom->width;
+    attrs->height = geom->height;
+    attrs->border_width = geom->border_width;
+    attrs->depth = geom->depth;
+    attrs->root = geom->root;
+    attrs->screen = find_screen(dpy, geom->root);
+    attrs->visual = find_visual(dpy, attrs->screen, wa->visual);
+    attrs->class = wa->_class;
+    attrs->bit_gravity = wa->bit_gravity;
+    attrs->win_gravity = wa->win_gravity;
+    attrs->backing_store = wa->backing_store;
+    attrs->backing_planes = wa->backing_planes;
+    attrs->backing_pixel = wa->backing_pixel;
+    attrs->save_under = wa->save_under;
+    attrs->colormap = wa->colormap;
+    attrs->map_installed = wa->map_is_installed;
+    attrs->map_state = wa->map_state;
+    attrs->all_event_masks = wa->all_event_masks;
+    attrs->your_event_mask = wa->your_event_mask;
+    attrs->do_not_propagate_mask = wa->do_not_propagate_mask;
+    attrs->override_redirect = wa->override_redirect;
+}
+
 // Batch update all window attributes
 // This is the ONLY place that queries attributes - not per-window in render loop!
 static void batch_update_attributes(Display *dpy, Window *windows, int count) {
@@ -81,23 +136,57 @@ static void batch_update_attributes(Display *dpy, Window *windows, int count) {
         g_attr_hash_capacity = new_capacity;
     }
 
+    xcb_get_window_attributes_cookie_t *attr_cookies = malloc(count * sizeof(*attr_cookies));
+    xcb_get_geometry_cookie_t *geom_cookies = malloc(count * sizeof(*geom_cookies));
+    if (!attr_cookies || !geom_cookies) {
+        log_error("[ERROR] Failed to allocate %d attribute cookies", count);
+        free(attr_cookies);
+        free(geom_cookies);
+        return;
+    }
+
     // Clear hash table for fresh batch (simpler than tombstone management)
     clear_hash_table();
 
-    // Insert all windows into hash table with their attributes
+    // Pass 1: send every request - nothing waits yet
+    // Xlib and xcb share the connection, so this stays ordered with whatever
+    // Xlib still has buffered
+    xcb_connection_t *xc = XGetXCBConnection(dpy);
     for (int i = 0; i < count; i++) {
+        attr_cookies[i] = xcb_get_window_attributes(xc, windows[i]);
+        geom_cookies[i] = xcb_get_geometry(xc, windows[i]);
+    }
+    xcb_flush(xc);
+
+    // Pass 2: collect replies - the first one pays the round trip, the rest
+    // are already queued. Errors (BadWindow from a window destroyed meanwhile)
+    // come back through the reply call, not the Xlib error handler.
+    for (int i = 0; i < count; i++) {
+        xcb_generic_error_t *attr_err = NULL, *geom_err = NULL;
+        xcb_get_window_attributes_reply_t *wa =
+            xcb_get_window_attributes_reply(xc, attr_cookies[i], &attr_err);
+        xcb_get_geometry_reply_t *geom =
+            xcb_get_geometry_reply(xc, geom_cookies[i], &geom_err);
+
         int slot = find_slot(windows[i]);
-        if (slot < 0) continue;  // Table full (shouldn't happen)
+        if (slot >= 0) {  // Table full shouldn't happen
+            if (!g_attr_hash_table[slot].occupied) g_attr_hash_count++;
+            g_attr_hash_table[slot].win = windows[i];
+            g_attr_hash_table[slot].occupied = true;
+            g_attr_hash_table[slot].valid = (wa && geom);
+            if (wa && geom) {
+                fill_attributes(dpy, &g_attr_hash_table[slot].attrs, wa, geom);
+            }
+        }
 
-        g_attr_hash_table[slot].win = windows[i];
-        g_attr_hash_table[slot].valid = XGetWindowAttributes(dpy, windows[i], &g_attr_hash_table[slot].attrs);
-        g_attr_hash_table[slot].occupied = true;
-        g_attr_hash_count++;
+        free(wa);
+        free(geom);
+        free(attr_err);
+        free(geom_err);
     }
 
-    // ONE XFlush at end instead of XSync per window
-    // This is the key optimization: async batch instead of sync per-window
-    XFlush(dpy);
+    free(attr_cookies);
+    free(geom_cookies);
 }
 
 // ============================================================================
@@ -132,7 +221,10 @@ XWindowAttributes *itn_attrs_get(Window win, bool *out_valid) {
 }
 
 // Initialize hash table
+// Startup adoption (frame_existing_client_windows) may already have run a
+// batch before the compositor starts - drop that table rather than leak it
 void itn_attrs_init(void) {
+    free(g_attr_hash_table);
     g_attr_hash_table = NULL;
     g_attr_hash_capacity = 0;
     g_attr_hash_count = 0;
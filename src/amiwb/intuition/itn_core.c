@@ -5,6 +5,7 @@
 #include "itn_internal.h"
 #include "../render/rnd_public.h"
 #include "../menus/menu_public.h"
+#include "../amiwbrc.h"  // For swap_mode
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>  // For XClassHint, XGetWMProtocols
 #include <X11/Xatom.h>
@@ -140,6 +141,13 @@ bool itn_core_init_compositor(void) {
         return false;
     }
 
+    // XFixes regions clip each frame to its damage (partial repaint)
+    int fixes_event, fixes_error;
+    if (!XFixesQueryExtension(dpy, &fixes_event, &fixes_error)) {
+        log_error("[ERROR] XFixes extension not available");
+        return false;
+    }
+
     // Try to acquire compositor selection
     char selname[32];
     snprintf(selname, sizeof(selname), "_NET_WM_CM_S%d", scr);
@@ -184,6 +192,22 @@ bool itn_core_init_compositor(void) {
         return false;
     }
 
+    // Optional CPU/MIT-SHM compositing backend - falls back to XRender
+    if (get_config()->composite_backend == 1) {
+        itn_shm_init(itn_composite_get_overlay_window(),
+                     itn_core_get_screen_width(), itn_core_get_screen_height());
+    }
+
+    // Optional Present swap backend (vblank-paced) - falls back to XRender copy
+    // Presents the XRender back pixmap, so it doesn't combine with the CPU backend
+    if (get_config()->swap_mode == 1) {
+        if (itn_shm_is_active()) {
+            log_error("[PRESENT] swap_mode 1 ignored - CPU compositing puts frames itself");
+        } else {
+            itn_present_init(itn_composite_get_overlay_window());
+        }
+    }
+
     // Initialize cache modules (Phase 1 optimization - event-driven caching)
     itn_stack_init();   // Window stacking cache (eliminates XQueryTree from hot path)
     itn_attrs_init();   // Window attributes cache (batch queries, not per-window XSync)
@@ -195,14 +219,25 @@ bool itn_core_init_compositor(void) {
     // Setup compositing for existing canvases
     // When compositor starts, existing windows need compositing setup
     int count = itn_manager_get_count();
+    Window *canvas_wins = count > 0 ? malloc(count * sizeof(Window)) : NULL;
+    int canvas_win_count = 0;
+    for (int i = 0; i < count && canvas_wins; i++) {
+        Canvas *c = itn_manager_get_canvas(i);
+        if (c && c->win) canvas_wins[canvas_win_count++] = c->win;
+    }
+    // One pipelined attribute batch instead of a round trip per canvas
+    itn_attrs_batch_update(dpy, canvas_wins, canvas_win_count);
+    free(canvas_wins);
+
     for (int i = 0; i < count; i++) {
         Canvas *c = itn_manager_get_canvas(i);
         if (!c || !c->win) continue;
 
         // Check if window is mapped
-        XWindowAttributes attrs;
-        if (safe_get_window_attributes(dpy, c->win, &attrs)) {
-            if (attrs.map_state == IsViewable && !c->comp_damage) {
+        bool valid = false;
+        XWindowAttributes *attrs = itn_attrs_get(c->win, &valid);
+        if (attrs && valid) {
+            if (attrs->map_state == IsViewable && !c->comp_damage) {
                 // Setup compositing for this existing canvas
                 itn_composite_setup_canvas(c);
             }
@@ -218,6 +253,9 @@ bool itn_core_init_compositor(void) {
     if (XQueryTree(dpy, root_win, &root_return, &parent_return, &children, &nchildren)) {
         int override_count = 0;
 
+        // Attributes for every root child in one pipelined batch
+        itn_attrs_batch_update(dpy, children, (int)nchildren);
+
         for (unsigned int i = 0; i < nchildren; i++) {
             Window w = children[i];
 
@@ -229,8 +267,10 @@ bool itn_core_init_compositor(void) {
             if (itn_canvas_find_by_window(w)) continue;
 
             // Check if it's an override-redirect window
-            XWindowAttributes attrs;
-            if (safe_get_window_attributes(dpy, w, &attrs)) {
+            bool valid = false;
+            XWindowAttributes *cached = itn_attrs_get(w, &valid);
+            if (cached && valid) {
+                XWindowAttributes attrs = *cached;
                 if (attrs.map_state == IsViewable && attrs.override_redirect &&
                     attrs.class == InputOutput) {
                     // Found an existing override-redirect window
@@ -873,7 +913,8 @@ void menubar_apply_fullscreen(bool fullscreen) {
         menubar->comp_visible = true;
     }
 
-    // Trigger compositor to update display
+    // Trigger compositor to update display (menubar area changed either way)
+    DAMAGE_CANVAS(menubar);
     SCHEDULE_FRAME();
 }
 
@@ -4,6 +4,7 @@
 #include "../config.h"
 #include "itn_internal.h"
 #include "../render/rnd_public.h"  // For get_font()
+#include "../font_manager.h"
 #include <X11/Xlib.h>
 #include <X11/Xft/Xft.h>
 #include <string.h>
@@ -34,7 +35,7 @@ static void update_title_width_cache(Canvas *canvas) {
         if (!display_title) display_title = "Untitled";
 
         XGlyphInfo extents;
-        XftTextExtentsUtf8(dpy, font, (FcChar8 *)display_title, strlen(display_title), &extents);
+        font_manager_text_extents(font, display_title, &extents);
         canvas->title_width = extents.xOff;
     } else {
         canvas->title_width = 0;
@@ -1,11 +1,19 @@
 // Window dragging operations
 // Handles titlebar dragging, position updates, client notification
+// During a drag the position lives in the compositor (canvas->x/y is where
+// itn_composite_render_all draws the frame). The X server only hears about it
+// every DRAG_SYNC_INTERVAL_MS and once on release - a busy server can't hold
+// back the drag, it just gets fewer XMoveWindow requests.
 
 #include "itn_drag.h"
 #include "itn_internal.h"
 #include "../config.h"
 #include "../workbench/wb_spatial.h"
 #include <X11/Xlib.h>
+#include <time.h>
+
+// Real window position is sent at most this often while dragging (20Hz)
+#define DRAG_SYNC_INTERVAL_MS 50
 
 // Module-private state (no longer extern - encapsulated)
 static Canvas *dragging_canvas = NULL;
@@ -14,6 +22,56 @@ static int drag_start_y = 0;
 static int window_start_x = 0;
 static int window_start_y = 0;
 
+// Position the X server (and client) last heard about
+static int synced_x = 0;
+static int synced_y = 0;
+static struct timespec last_sync = {0, 0};
+
+// ============================================================================
+// Internal Implementation
+// ============================================================================
+
+// Move the real frame window to the compositor position and tell the client
+static void sync_position(Display *dpy, Canvas *canvas) {
+    if (canvas->x == synced_x && canvas->y == synced_y) return;
+
+    XMoveWindow(dpy, canvas->win, canvas->x, canvas->y);
+    synced_x = canvas->x;
+    synced_y = canvas->y;
+    clock_gettime(CLOCK_MONOTONIC, &last_sync);
+
+    // Send ConfigureNotify to client window so it knows its new position
+    // This is crucial for apps with menus (Steam, fs-uae-launcher, etc)
+    if (canvas->client_win != None) {
+        XConfigureEvent ce;
+        ce.type = ConfigureNotify;
+        ce.display = dpy;
+        ce.event = canvas->client_win;
+        ce.window = canvas->client_win;
+        // Send root-relative coordinates (frame position + decoration offsets)
+        ce.x = canvas->x + BORDER_WIDTH_LEFT;
+        ce.y = canvas->y + BORDER_HEIGHT_TOP;
+        // Client dimensions (subtract decorations from frame size)
+        int right_border = (canvas->client_win == None ? BORDER_WIDTH_RIGHT : BORDER_WIDTH_RIGHT_CLIENT);
+        ce.width = canvas->width - BORDER_WIDTH_LEFT - right_border;
+        ce.height = canvas->height - BORDER_HEIGHT_TOP - BORDER_HEIGHT_BOTTOM;
+
+        ce.border_width = 0;
+        ce.above = None;
+        ce.override_redirect = False;
+        XSendEvent(dpy, canvas->client_win, False,
+                  StructureNotifyMask, (XEvent *)&ce);
+    }
+}
+
+static bool sync_due(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long elapsed_ms = (now.tv_sec - last_sync.tv_sec) * 1000L +
+                      (now.tv_nsec - last_sync.tv_nsec) / 1000000L;
+    return elapsed_ms >= DRAG_SYNC_INTERVAL_MS;
+}
+
 // ============================================================================
 // Public API Implementation
 // ============================================================================
@@ -30,6 +88,9 @@ bool itn_drag_start(Canvas *canvas, int x_root, int y_root) {
     drag_start_y = y_root;
     window_start_x = canvas->x;
     window_start_y = canvas->y;
+    synced_x = canvas->x;
+    synced_y = canvas->y;
+    last_sync = (struct timespec){0, 0};  // First motion syncs right away
 
     // Grab pointer for smooth dragging
     XGrabPointer(dpy, canvas->win, False,
@@ -56,33 +117,17 @@ bool itn_drag_motion(XMotionEvent *event) {
     // Damage old position
     DAMAGE_CANVAS(dragging_canvas);
 
-    XMoveWindow(dpy, dragging_canvas->win, window_start_x, window_start_y);
+    // Compositor position first - the next frame draws the window here
     dragging_canvas->x = window_start_x;
     dragging_canvas->y = window_start_y;
     drag_start_x = event->x_root;
     drag_start_y = event->y_root;
 
-    // Send ConfigureNotify to client window so it knows its new position
-    // This is crucial for apps with menus (Steam, fs-uae-launcher, etc)
-    if (dragging_canvas->client_win != None) {
-        XConfigureEvent ce;
-        ce.type = ConfigureNotify;
-        ce.display = dpy;
-        ce.event = dragging_canvas->client_win;
-        ce.window = dragging_canvas->client_win;
-        // Send root-relative coordinates (frame position + decoration offsets)
-        ce.x = window_start_x + BORDER_WIDTH_LEFT;
-        ce.y = window_start_y + BORDER_HEIGHT_TOP;
-        // Client dimensions (subtract decorations from frame size)
-        int right_border = (dragging_canvas->client_win == None ? BORDER_WIDTH_RIGHT : BORDER_WIDTH_RIGHT_CLIENT);
-        ce.width = dragging_canvas->width - BORDER_WIDTH_LEFT - right_border;
-        ce.height = dragging_canvas->height - BORDER_HEIGHT_TOP - BORDER_HEIGHT_BOTTOM;
-
-        ce.border_width = 0;
-        ce.above = None;
-        ce.override_redirect = False;
-        XSendEvent(dpy, dragging_canvas->client_win, False,
-                  StructureNotifyMask, (XEvent *)&ce);
+    // Real window follows at a throttled rate (pointer is grabbed, so input
+    // doesn't care where the X window is meanwhile)
+    // Without compositing the X window IS what's on screen - always move it
+    if (!itn_composite_is_active() || sync_due()) {
+        sync_position(dpy, dragging_canvas);
     }
 
     // Damage new position
@@ -99,6 +144,9 @@ void itn_drag_end(void) {
     Display *dpy = itn_core_get_display();
     if (!dpy) return;
 
+    // Final position to the X server and client (throttle may have skipped it)
+    sync_position(dpy, dragging_canvas);
+
     // Save window geometry for spatial mode (workbench windows only)
     if (dragging_canvas->type == WINDOW && dragging_canvas->path) {
         wb_spatial_save_geometry(dragging_canvas->path,
@@ -115,6 +163,8 @@ void itn_drag_end(void) {
     drag_start_y = 0;
     window_start_x = 0;
     window_start_y = 0;
+    synced_x = 0;
+    synced_y = 0;
 }
 
 // Query if drag is active
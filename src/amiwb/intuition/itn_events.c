@@ -287,14 +287,17 @@ void intuition_handle_button_press(XButtonEvent *event) {
 
     // Handle mouse wheel scrolling for non-client windows
     if (canvas->client_win == None && !canvas->disable_scrollbars) {
+        int old_scroll_y = canvas->scroll_y;
         if (event->button == Button4) {  // Scroll up
             canvas->scroll_y = max(0, canvas->scroll_y - SCROLL_STEP);
+            render_scroll_canvas(canvas, canvas->scroll_x, old_scroll_y);
             DAMAGE_CANVAS(canvas);
             SCHEDULE_FRAME();
             g_last_press_consumed = true;  // Wheel scroll consumed
             return;
         } else if (event->button == Button5) {  // Scroll down
             canvas->scroll_y = min(canvas->max_scroll_y, canvas->scroll_y + SCROLL_STEP);
+            render_scroll_canvas(canvas, canvas->scroll_x, old_scroll_y);
             DAMAGE_CANVAS(canvas);
             SCHEDULE_FRAME();
             g_last_press_consumed = true;  // Wheel scroll consumed
@@ -526,8 +529,12 @@ void intuition_handle_map_notify(XMapEvent *event) {
         return;
     }
 
-    // Ignore if this is one of our frame windows or already managed as client
-    if (itn_canvas_find_by_window(event->window) || itn_canvas_find_by_client(event->window)) {
+    // Our frame or an already managed client: nothing to frame, but mapping
+    // gives the frame a new backing pixmap - re-name it at the next frame
+    Canvas *mapped = itn_canvas_find_by_window(event->window);
+    if (!mapped) mapped = itn_canvas_find_by_client(event->window);
+    if (mapped) {
+        itn_composite_mark_pixmap_stale(mapped);
         return;
     }
 
@@ -542,6 +549,17 @@ void intuition_handle_map_notify(XMapEvent *event) {
     frame_and_activate(event->window, &attrs, true);
 }
 
+// Handle ReparentNotify - client moved into (or out of) one of our frames
+void intuition_handle_reparent_notify(XReparentEvent *event) {
+    Canvas *canvas = itn_canvas_find_by_client(event->window);
+    if (!canvas) return;
+
+    // Client now lives inside the frame - refresh the named pixmap once
+    if (event->parent == canvas->win) {
+        itn_composite_mark_pixmap_stale(canvas);
+    }
+}
+
 // ============================================================================
 // Configure Request/Notify Events
 // ============================================================================
@@ -867,6 +885,10 @@ void intuition_handle_rr_screen_change(XRRScreenChangeNotifyEvent *event) {
 
     itn_core_set_screen_dimensions(event->width, event->height);
 
+    // Monitors may have been added, moved or changed refresh rate
+    // (before the wallpaper reload - it scales per monitor)
+    itn_render_outputs_changed();
+
     // CRITICAL: Recreate compositor back buffer for new screen dimensions
     // Without this, compositor is stuck rendering into old-sized buffer (black bands)
     if (itn_composite_is_active()) {
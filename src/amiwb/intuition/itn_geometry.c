@@ -145,7 +145,16 @@ void itn_geometry_apply_resize(Canvas *c, int nw, int nh) {
     }
 
     // Skip expensive buffer recreation during interactive resize
-    if (!c->resizing_interactive) {
+    // (the buffer is oversized then - only regrow once the frame outgrows it)
+    if (c->resizing_interactive) {
+        if (nw > c->buffer_width || nh > c->buffer_height) {
+            int screen_w = itn_core_get_screen_width();
+            int screen_h = itn_core_get_screen_height();
+            c->buffer_width = max(nw, min(nw + nw / 2, screen_w));
+            c->buffer_height = max(nh, min(nh + nh / 2, screen_h));
+            render_recreate_canvas_surfaces(c);
+        }
+    } else {
         render_recreate_canvas_surfaces(c);
 
         // After resize, compositor pixmap needs update + decorations redrawn
@@ -157,26 +166,10 @@ void itn_geometry_apply_resize(Canvas *c, int nw, int nh) {
     }
 
     if (c->client_win != None) {
-        // Calculate content area (excluding borders)
-        int client_width, client_height;
-        if (c->fullscreen) {
-            client_width = max(1, c->width);
-            client_height = max(1, c->height);
-        } else {
-            int right_border = (c->client_win == None ? BORDER_WIDTH_RIGHT : BORDER_WIDTH_RIGHT_CLIENT);
-            client_width = max(1, c->width - BORDER_WIDTH_LEFT - right_border);
-            client_height = max(1, c->height - BORDER_HEIGHT_TOP - BORDER_HEIGHT_BOTTOM);
+        // Interactive resize paces client configures itself (itn_resize.c)
+        if (!c->resizing_interactive) {
+            itn_geometry_configure_client(c, NULL, NULL);
         }
-
-        // MUST also set position to ensure client stays within borders!
-        Display *dpy = itn_core_get_display();
-        XWindowChanges ch = {
-            .x = BORDER_WIDTH_LEFT,
-            .y = BORDER_HEIGHT_TOP,
-            .width = client_width,
-            .height = client_height
-        };
-        XConfigureWindow(dpy, c->client_win, CWX | CWY | CWWidth | CWHeight, &ch);
     } else if (c->type == WINDOW) {
         compute_max_scroll(c);
     }
@@ -186,6 +179,36 @@ void itn_geometry_apply_resize(Canvas *c, int nw, int nh) {
     SCHEDULE_FRAME();
 }
 
+// Size the client window to the frame's content area
+// Optionally returns the size that was sent
+void itn_geometry_configure_client(Canvas *c, int *out_width, int *out_height) {
+    if (!c || c->client_win == None) return;
+
+    // Calculate content area (excluding borders)
+    int client_width, client_height;
+    if (c->fullscreen) {
+        client_width = max(1, c->width);
+        client_height = max(1, c->height);
+    } else {
+        int right_border = (c->client_win == None ? BORDER_WIDTH_RIGHT : BORDER_WIDTH_RIGHT_CLIENT);
+        client_width = max(1, c->width - BORDER_WIDTH_LEFT - right_border);
+        client_height = max(1, c->height - BORDER_HEIGHT_TOP - BORDER_HEIGHT_BOTTOM);
+    }
+
+    // MUST also set position to ensure client stays within borders!
+    Display *dpy = itn_core_get_display();
+    XWindowChanges ch = {
+        .x = BORDER_WIDTH_LEFT,
+        .y = BORDER_HEIGHT_TOP,
+        .width = client_width,
+        .height = client_height
+    };
+    XConfigureWindow(dpy, c->client_win, CWX | CWY | CWWidth | CWHeight, &ch);
+
+    if (out_width) *out_width = client_width;
+    if (out_height) *out_height = client_height;
+}
+
 // ============================================================================
 // Scroll Management
 // ============================================================================
@@ -261,6 +284,8 @@ void update_scroll_from_mouse_drag(Canvas *canvas, bool is_vertical, int initial
     int new_scroll = (max_scroll > 0) ? (int)roundf((new_knob_pos / (float)available_track_space) * (float)max_scroll) : 0;
 
     // Update the appropriate scroll value
+    int old_scroll_x = canvas->scroll_x;
+    int old_scroll_y = canvas->scroll_y;
     if (is_vertical) {
         canvas->scroll_y = new_scroll;
     } else {
@@ -269,7 +294,8 @@ void update_scroll_from_mouse_drag(Canvas *canvas, bool is_vertical, int initial
 
     // CRITICAL FIX: Must redraw canvas buffer to update scrollbar knob position and scrolled content
     // DAMAGE_CANVAS/SCHEDULE_FRAME only tell compositor to composite - they don't redraw the buffer!
-    redraw_canvas(canvas);
+    // Blit what's already drawn and render only the strip that scrolled into view
+    render_scroll_canvas(canvas, old_scroll_x, old_scroll_y);
     DAMAGE_CANVAS(canvas);
     SCHEDULE_FRAME();
 }
@@ -0,0 +1,123 @@
+// File: itn_index.c
+// XID lookup index - O(1) Window/Damage -> object mapping for event hot paths
+// Open addressing with linear probing (same scheme as the attribute cache)
+
+#include "itn_internal.h"
+#include "../config.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+#define INITIAL_INDEX_CAPACITY 32  // Power of 2
+
+// ============================================================================
+// Internal Implementation
+// ============================================================================
+
+// Hash function: multiplicative hash - XIDs from one client share high bits
+// and are often allocated in steps, so plain masking clusters badly
+static inline int hash_xid(XID key, int capacity) {
+    return (int)(((uint32_t)key * 2654435761u) & (uint32_t)(capacity - 1));
+}
+
+// Find slot for key (insert or lookup)
+// Returns index where key is found or should be inserted, -1 if table full
+static int find_slot(const ItnIndex *idx, XID key) {
+    if (idx->capacity == 0) return -1;
+
+    int index = hash_xid(key, idx->capacity);
+    int start = index;
+
+    // Linear probing: search until we find the key or an empty slot
+    do {
+        if (idx->slots[index].key == None || idx->slots[index].key == key) {
+            return index;
+        }
+        index = (index + 1) & (idx->capacity - 1);
+    } while (index != start);
+
+    return -1;
+}
+
+// Resize table, re-inserting all live entries
+static bool rehash(ItnIndex *idx, int new_capacity) {
+    ItnIndexEntry *old_slots = idx->slots;
+    int old_capacity = idx->capacity;
+
+    ItnIndexEntry *new_slots = calloc(new_capacity, sizeof(ItnIndexEntry));
+    if (!new_slots) {
+        log_error("[ERROR] Failed to grow window index to %d entries", new_capacity);
+        return false;
+    }
+
+    idx->slots = new_slots;
+    idx->capacity = new_capacity;
+    idx->count = 0;
+
+    for (int i = 0; i < old_capacity; i++) {
+        if (old_slots[i].key != None) {
+            int slot = find_slot(idx, old_slots[i].key);
+            idx->slots[slot] = old_slots[i];
+            idx->count++;
+        }
+    }
+
+    free(old_slots);
+    return true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+// Map key to value (overwrites existing mapping). None keys are ignored.
+bool itn_index_put(ItnIndex *idx, XID key, void *value) {
+    if (!idx || key == None) return false;
+
+    // Keep load factor below 0.5 for short probe chains
+    if ((idx->count + 1) * 2 > idx->capacity) {
+        int new_capacity = idx->capacity ? idx->capacity * 2 : INITIAL_INDEX_CAPACITY;
+        if (!rehash(idx, new_capacity)) return false;
+    }
+
+    int slot = find_slot(idx, key);
+    if (slot < 0) return false;
+
+    if (idx->slots[slot].key == None) {
+        idx->slots[slot].key = key;
+        idx->count++;
+    }
+    idx->slots[slot].value = value;
+    return true;
+}
+
+// Lookup value for key (NULL if not indexed)
+// Callers must still verify the object's current XID - entries for keys an
+// object no longer uses are only purged on the next clear/rebuild
+void *itn_index_get(const ItnIndex *idx, XID key) {
+    if (!idx || key == None) return NULL;
+
+    int slot = find_slot(idx, key);
+    if (slot < 0 || idx->slots[slot].key != key) return NULL;
+    return idx->slots[slot].value;
+}
+
+// Drop all entries (keeps allocation for the rebuild that usually follows)
+void itn_index_clear(ItnIndex *idx) {
+    if (!idx || !idx->slots) return;
+    memset(idx->slots, 0, idx->capacity * sizeof(ItnIndexEntry));
+    idx->count = 0;
+}
+
+// Free table memory (call during shutdown)
+void itn_index_free(ItnIndex *idx) {
+    if (!idx) return;
+    free(idx->slots);
+    idx->slots = NULL;
+    idx->capacity = 0;
+    idx->count = 0;
+}
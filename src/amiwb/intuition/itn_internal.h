@@ -10,6 +10,7 @@
 #include <X11/extensions/Xrender.h>
 #include <X11/extensions/Xdamage.h>
 #include <X11/extensions/Xcomposite.h>
+#include <X11/extensions/Xfixes.h>
 #include <stdbool.h>
 #include <time.h>
 
@@ -54,6 +55,92 @@ void request_client_close(Canvas *canvas);
 void iconify_canvas(Canvas *canvas);
 Canvas *create_canvas(const char *path, int x, int y, int w, int h, CanvasType type);
 
+// --- itn_index.c ---
+// XID -> object hash index for O(1) event lookups (Window or Damage keys)
+typedef struct {
+    XID key;       // None = empty slot
+    void *value;
+} ItnIndexEntry;
+
+typedef struct {
+    ItnIndexEntry *slots;
+    int capacity;  // Power of 2
+    int count;
+} ItnIndex;
+
+bool itn_index_put(ItnIndex *idx, XID key, void *value);
+void *itn_index_get(const ItnIndex *idx, XID key);
+void itn_index_clear(ItnIndex *idx);
+void itn_index_free(ItnIndex *idx);
+
+// --- itn_present.c ---
+// Optional Present swap backend (amiwbrc swap_mode = 1)
+bool itn_present_init(Window window);
+void itn_present_cleanup(void);
+bool itn_present_is_active(void);
+bool itn_present_is_pending(void);
+void itn_present_swap(Pixmap pixmap, XserverRegion update);
+bool itn_present_handle_event(XEvent *event);
+void itn_present_check_timeout(void);
+long itn_present_timeout_ns(void);
+void itn_present_log_metrics(void);
+
+// --- itn_shm.c ---
+// Optional CPU compositing backend (amiwbrc composite_backend = 1)
+bool itn_shm_init(Window target, int width, int height);
+void itn_shm_cleanup(void);
+bool itn_shm_is_active(void);
+bool itn_shm_resize(int width, int height);
+void itn_shm_draw_background(const XRectangle *rects, int count,
+                             Pixmap wallpaper, int wall_w, int wall_h);
+void itn_shm_composite(Drawable src, int depth, int origin_x, int origin_y,
+                       const XRectangle *rects, int count);
+void itn_shm_composite_stretched(Drawable src, int depth, int origin_x, int origin_y,
+                                 const XRectangle *content, int src_w, int src_h,
+                                 const XRectangle *rects, int count);
+void itn_shm_swap(const XRectangle *rects, int count);
+void itn_shm_log_metrics(void);
+
+// --- itn_blend.c ---
+// Premultiplied ARGB32 row kernels (scalar/SSE2/AVX2, chosen at runtime)
+void itn_blend_init(void);
+const char *itn_blend_kernel_name(void);
+void itn_blend_over_row(uint32_t *dst, const uint32_t *src, int n);
+void itn_blend_copy_row(uint32_t *dst, const uint32_t *src, int n);
+void itn_blend_scale_row(uint32_t *dst, const uint32_t *src, uint32_t u0, uint32_t du, int n);
+
+// --- itn_outputs.c ---
+// Monitors from XRandR (RandR 1.5 monitors, else CRTCs, else whole screen)
+// (MAX_OUTPUTS lives in itn_public.h - wallpaper scaling sizes arrays by it)
+
+typedef struct {
+    char name[32];
+    XRectangle rect;       // Root coordinates
+    double refresh_hz;     // 0 when unknown
+} ItnOutput;
+
+void itn_outputs_refresh(void);
+int itn_outputs_count(void);
+const ItnOutput *itn_outputs_get(int index);
+
+// --- itn_trace.c ---
+// Frame phases timed by the compositor (itn_trace_mark)
+typedef enum {
+    ITN_PHASE_STACK,       // Stacking order walk / visible canvas list
+    ITN_PHASE_RENAME,      // XCompositeNameWindowPixmap + Picture re-creation
+    ITN_PHASE_COMPOSITE,   // Occlusion, background and canvas composites
+    ITN_PHASE_OVERRIDES,   // Override-redirect composites
+    ITN_PHASE_SWAP,        // Back buffer to overlay (copy or Present)
+    ITN_PHASE_COUNT
+} ItnPhase;
+
+void itn_trace_frame_begin(void);
+void itn_trace_mark(ItnPhase phase);
+void itn_trace_frame_end(void);
+void itn_trace_input_begin(void);
+void itn_trace_input_end(void);
+void itn_trace_log_metrics(void);
+
 // --- itn_manager.c ---
 Canvas *itn_manager_get_canvas(int index);
 int itn_manager_get_count(void);
@@ -64,6 +151,10 @@ void itn_manager_remove(Canvas *canvas);
 Canvas *itn_manager_find_by_predicate(bool (*predicate)(Canvas*, void*), void *ctx);
 void itn_manager_foreach(void (*callback)(Canvas*, void*), void *ctx);
 void itn_manager_cleanup(void);
+void itn_manager_index_canvas(Canvas *canvas);  // Call after win/client_win/comp_damage change
+Canvas *itn_manager_find_by_window(Window win);
+Canvas *itn_manager_find_by_client(Window client);
+Canvas *itn_manager_find_by_damage(Damage damage);
 
 // --- itn_geometry.c ---
 void itn_geometry_move(Canvas *canvas, int x, int y);
@@ -73,16 +164,28 @@ void itn_geometry_raise(Canvas *canvas);
 void itn_geometry_lower(Canvas *canvas);
 void itn_geometry_restack(void);
 void itn_geometry_apply_resize(Canvas *c, int nw, int nh);
+void itn_geometry_configure_client(Canvas *c, int *out_width, int *out_height);
 void compute_max_scroll(Canvas *c);
 
 // --- itn_render.c ---
+// Max disjoint damage rectangles kept per frame - beyond this they get merged
+#define MAX_DAMAGE_RECTS 16
+
 void itn_render_accumulate_damage(int x, int y, int width, int height);
 void itn_render_accumulate_canvas_damage(Canvas *canvas);
+uint64_t itn_render_damage_serial(void);
+int itn_render_get_damage_rects(const XRectangle **rects);
+void itn_render_get_output_bounds(XRectangle *bounds);
+void itn_render_outputs_changed(void);
+void itn_render_record_repaint(bool full, uint64_t pixels);
+void itn_render_record_pixmap_rename(void);
+void itn_render_record_motion(int coalesced);
+void itn_render_frame_presented(void);
 void itn_render_schedule_frame(void);
 void itn_render_process_frame(void);
 bool itn_render_init_frame_scheduler(void);
 void itn_render_cleanup_frame_scheduler(void);
-void itn_render_damaged_canvases(void);
+void itn_render_damaged_canvases(const bool *due);
 bool itn_render_needs_frame(void);
 int itn_render_get_timer_fd(void);
 void itn_render_consume_timer(void);
@@ -110,6 +213,7 @@ void itn_composite_send_expose(Canvas *canvas);
 bool itn_composite_needs_frame(void);
 void itn_composite_reorder_windows(void);
 void itn_composite_swap_buffers(void);
+void itn_composite_bypass_release(Canvas *canvas);
 
 // --- itn_composite_stack.c ---
 void itn_stack_mark_dirty(void);
@@ -160,11 +264,16 @@ void itn_resize_cancel(void);
 bool itn_resize_is_active(void);
 Canvas *itn_resize_get_target(void);
 void itn_resize_motion(int mouse_x, int mouse_y);
+void itn_resize_flush_frame(void);
+void itn_resize_canvas_destroyed(Canvas *canvas);
+void itn_resize_client_damaged(Canvas *canvas, int drawn_width, int drawn_height);
+bool itn_resize_client_lag(Canvas *canvas, int *client_width, int *client_height);
 
 // Composite module - override-redirect window management
 void itn_composite_add_override(Window win, XWindowAttributes *attrs);
 void itn_composite_update_override_position(Window win, int x, int y);
 void itn_composite_update_canvas_pixmap(Canvas *canvas);
+void itn_composite_mark_pixmap_stale(Canvas *canvas);
 
 // ============================================================================
 // Utility Macros
@@ -20,6 +20,27 @@ static Canvas **g_canvas_array = NULL;
 static int g_canvas_count = 0;
 static int g_canvas_array_size = 0;
 
+// Lookup indexes for the event/damage hot paths (frame window, client window, Damage)
+// Entries are added when a key is set and purged by rebuilding on removal
+static ItnIndex g_by_window = {0};
+static ItnIndex g_by_client = {0};
+static ItnIndex g_by_damage = {0};
+
+// ============================================================================
+// Internal Implementation
+// ============================================================================
+
+// Rebuild all indexes from the array - drops entries of removed canvases
+// and keys a canvas no longer uses. O(n) but only runs on removal.
+static void rebuild_indexes(void) {
+    itn_index_clear(&g_by_window);
+    itn_index_clear(&g_by_client);
+    itn_index_clear(&g_by_damage);
+    for (int i = 0; i < g_canvas_count; i++) {
+        itn_manager_index_canvas(g_canvas_array[i]);
+    }
+}
+
 // ============================================================================
 // Public API Implementation
 // ============================================================================
@@ -67,6 +88,7 @@ bool itn_manager_add(Canvas *canvas) {
     // Add canvas to end of array
     g_canvas_array[g_canvas_count] = canvas;
     g_canvas_count++;
+    itn_manager_index_canvas(canvas);
     return true;
 }
 
@@ -83,6 +105,7 @@ void itn_manager_remove(Canvas *canvas) {
             }
             g_canvas_count--;
             g_canvas_array[g_canvas_count] = NULL;
+            rebuild_indexes();
 
             // Shrink array if usage drops below 25% and we're above initial size
             // This prevents unbounded memory growth in long-running sessions
@@ -104,6 +127,35 @@ void itn_manager_remove(Canvas *canvas) {
     }
 }
 
+// Index a canvas under its current frame window, client window and Damage
+// Canvases get their XIDs after itn_manager_add, so creation paths call this
+// again once win/client_win/comp_damage are set. Old keys are harmless: lookups
+// verify the canvas still uses the key, removal rebuilds the tables.
+void itn_manager_index_canvas(Canvas *canvas) {
+    if (!canvas) return;
+    itn_index_put(&g_by_window, canvas->win, canvas);
+    itn_index_put(&g_by_client, canvas->client_win, canvas);
+    itn_index_put(&g_by_damage, canvas->comp_damage, canvas);
+}
+
+// Find canvas by frame window - O(1)
+Canvas *itn_manager_find_by_window(Window win) {
+    Canvas *c = itn_index_get(&g_by_window, win);
+    return (c && c->win == win) ? c : NULL;
+}
+
+// Find canvas by client window - O(1)
+Canvas *itn_manager_find_by_client(Window client) {
+    Canvas *c = itn_index_get(&g_by_client, client);
+    return (c && c->client_win == client) ? c : NULL;
+}
+
+// Find canvas by Damage handle - O(1)
+Canvas *itn_manager_find_by_damage(Damage damage) {
+    Canvas *c = itn_index_get(&g_by_damage, damage);
+    return (c && c->comp_damage == damage) ? c : NULL;
+}
+
 // Find first canvas matching predicate
 // Predicate receives canvas and user context, returns true to select
 Canvas *itn_manager_find_by_predicate(bool (*predicate)(Canvas*, void*), void *ctx) {
@@ -138,4 +190,7 @@ void itn_manager_cleanup(void) {
     }
     g_canvas_count = 0;
     g_canvas_array_size = 0;
+    itn_index_free(&g_by_window);
+    itn_index_free(&g_by_client);
+    itn_index_free(&g_by_damage);
 }
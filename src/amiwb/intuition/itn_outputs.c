@@ -0,0 +1,168 @@
+// File: itn_outputs.c
+// Output (monitor) discovery through XRandR - geometry and refresh rate
+// RandR 1.5 monitors first: they include `xrandr --setmonitor` virtual
+// monitors, so multi-head behaviour can be tried on a single Xvfb screen.
+// Older servers: one output per active CRTC. No RandR: the whole screen.
+// itn_render.c keeps damage and a frame cadence per output from this list.
+
+#include "itn_internal.h"
+#include "../config.h"
+#include <X11/Xlib.h>
+#include <X11/extensions/Xrandr.h>
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+// Module-Private State
+// ============================================================================
+
+static ItnOutput g_outputs[MAX_OUTPUTS];
+static int g_output_count = 0;
+
+// ============================================================================
+// Internal Implementation
+// ============================================================================
+
+// Refresh rate of a mode in Hz (0 if the mode doesn't say)
+static double mode_refresh(const XRRModeInfo *mode) {
+    if (!mode || !mode->hTotal || !mode->vTotal) return 0.0;
+
+    double vtotal = mode->vTotal;
+    if (mode->modeFlags & RR_DoubleScan) vtotal *= 2;
+    if (mode->modeFlags & RR_Interlace) vtotal /= 2;
+    return (double)mode->dotClock / ((double)mode->hTotal * vtotal);
+}
+
+static double crtc_refresh(XRRScreenResources *res, XRRCrtcInfo *crtc) {
+    for (int m = 0; m < res->nmode; m++) {
+        if (res->modes[m].id == crtc->mode) {
+            return mode_refresh(&res->modes[m]);
+        }
+    }
+    return 0.0;
+}
+
+static int overlap_area(int ax, int ay, int aw, int ah, int bx, int by, int bw, int bh) {
+    int w = min(ax + aw, bx + bw) - max(ax, bx);
+    int h = min(ay + ah, by + bh) - max(ay, by);
+    return (w > 0 && h > 0) ? w * h : 0;
+}
+
+// Refresh of the CRTC that shows most of a rectangle
+// Virtual monitors have no CRTC of their own - they inherit the one under them
+static double refresh_for_rect(Display *dpy, XRRScreenResources *res, const XRectangle *r) {
+    double best_hz = 0.0;
+    int best_area = 0;
+    for (int c = 0; c < res->ncrtc; c++) {
+        XRRCrtcInfo *crtc = XRRGetCrtcInfo(dpy, res, res->crtcs[c]);
+        if (!crtc) continue;
+        if (crtc->mode != None) {
+            int area = overlap_area(r->x, r->y, r->width, r->height,
+                                    crtc->x, crtc->y, crtc->width, crtc->height);
+            if (area > best_area) {
+                best_area = area;
+                best_hz = crtc_refresh(res, crtc);
+            }
+        }
+        XRRFreeCrtcInfo(crtc);
+    }
+    return best_hz;
+}
+
+static void add_output(const char *name, int x, int y, int w, int h, double hz) {
+    if (g_output_count >= MAX_OUTPUTS || w <= 0 || h <= 0) return;
+    ItnOutput *o = &g_outputs[g_output_count++];
+    memset(o, 0, sizeof(*o));
+    snprintf(o->name, sizeof(o->name), "%s", name ? name : "screen");
+    o->rect = (XRectangle){x, y, w, h};
+    o->refresh_hz = hz;
+}
+
+// RandR 1.5 monitors (includes --setmonitor virtual monitors)
+static void scan_monitors(Display *dpy, Window root, XRRScreenResources *res) {
+    int count = 0;
+    XRRMonitorInfo *monitors = XRRGetMonitors(dpy, root, True, &count);
+    if (!monitors) return;
+
+    for (int i = 0; i < count; i++) {
+        XRRMonitorInfo *m = &monitors[i];
+        XRectangle r = {m->x, m->y, m->width, m->height};
+        char *name = m->name ? XGetAtomName(dpy, m->name) : NULL;
+        add_output(name, m->x, m->y, m->width, m->height,
+                   res ? refresh_for_rect(dpy, res, &r) : 0.0);
+        if (name) XFree(name);
+    }
+    XRRFreeMonitors(monitors);
+}
+
+// Pre-1.5 servers: every CRTC that has a mode is an output
+static void scan_crtcs(Display *dpy, XRRScreenResources *res) {
+    for (int c = 0; c < res->ncrtc; c++) {
+        XRRCrtcInfo *crtc = XRRGetCrtcInfo(dpy, res, res->crtcs[c]);
+        if (!crtc) continue;
+        if (crtc->mode != None) {
+            char name[32];
+            snprintf(name, sizeof(name), "crtc-%d", c);
+            add_output(name, crtc->x, crtc->y, crtc->width, crtc->height,
+                       crtc_refresh(res, crtc));
+        }
+        XRRFreeCrtcInfo(crtc);
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+// Re-read outputs (startup and RRScreenChangeNotify)
+void itn_outputs_refresh(void) {
+    Display *dpy = itn_core_get_display();
+    g_output_count = 0;
+    if (!dpy) return;
+
+    Window root = itn_core_get_root();
+    int event_base, error_base, major = 0, minor = 0;
+    if (XRRQueryExtension(dpy, &event_base, &error_base) &&
+        XRRQueryVersion(dpy, &major, &minor)) {
+        XRRScreenResources *res = XRRGetScreenResourcesCurrent(dpy, root);
+
+        if (major > 1 || (major == 1 && minor >= 5)) {
+            scan_monitors(dpy, root, res);
+        }
+        if (g_output_count == 0 && res) {
+            scan_crtcs(dpy, res);
+        }
+        if (res) XRRFreeScreenResources(res);
+    }
+
+    // No RandR, or nothing lit (Xvfb without modes): one output, whole screen
+    if (g_output_count == 0) {
+        add_output("screen", 0, 0, itn_core_get_screen_width(), itn_core_get_screen_height(), 0.0);
+    }
+
+    for (int i = 0; i < g_output_count; i++) {
+        ItnOutput *o = &g_outputs[i];
+        log_error("[OUTPUTS] %s: %dx%d+%d+%d @ %.2f Hz", o->name,
+                  o->rect.width, o->rect.height, o->rect.x, o->rect.y, o->refresh_hz);
+    }
+}
+
+int itn_outputs_count(void) {
+    return g_output_count;
+}
+
+const ItnOutput *itn_outputs_get(int index) {
+    if (index < 0 || index >= g_output_count) return NULL;
+    return &g_outputs[index];
+}
+
+// Output rectangles for other modules (wallpaper scaling) - returns count
+// (wallpapers can load before the frame scheduler has read the outputs)
+int itn_outputs_get_rects(XRectangle *rects, int max_rects) {
+    if (g_output_count == 0) itn_outputs_refresh();
+    int n = min(g_output_count, max_rects);
+    for (int i = 0; i < n; i++) {
+        rects[i] = g_outputs[i].rect;
+    }
+    return n;
+}
@@ -0,0 +1,211 @@
+// File: itn_present.c
+// Present extension swap backend - vblank-paced buffer swaps
+// Optional (amiwbrc swap_mode = 1). The back buffer is presented to the overlay
+// with PresentOptionCopy and the next frame waits for PresentCompleteNotify,
+// so frames follow the real refresh (MSC/UST) instead of a guessed interval.
+// Works against Xvfb too: its Present fake CRTC ticks at 60Hz.
+
+#include "itn_internal.h"
+#include "../config.h"
+#include <X11/Xlib.h>
+#include <X11/extensions/Xfixes.h>
+#include <X11/extensions/Xpresent.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+// Give up waiting for PresentCompleteNotify after this long (window unmapped,
+// server lost the event) - next swap goes out without waiting
+#define PRESENT_TIMEOUT_MS 100
+
+// ============================================================================
+// Module-Private State
+// ============================================================================
+
+static bool g_present_active = false;
+static int g_present_opcode = 0;        // Major opcode - identifies our GenericEvents
+static Window g_present_window = None;
+static XID g_present_eid = None;        // Event context from XPresentSelectInput
+static uint32_t g_present_serial = 0;
+static bool g_present_pending = false;  // Swap sent, completion not yet seen
+static struct timespec g_present_sent;
+
+// Last completion - consecutive pairs give the measured refresh interval
+static uint64_t g_last_ust = 0;
+static uint64_t g_last_msc = 0;
+
+static struct {
+    uint64_t presents;
+    uint64_t completes;
+    uint64_t skipped;          // Completed in Skip mode (replaced before shown)
+    uint64_t missed_vblanks;   // MSC advanced by more than one between completions
+    uint64_t timeouts;
+    uint64_t refresh_us_sum;   // Sum of UST deltas per MSC for the average
+    uint64_t refresh_samples;
+} g_present_stats = {0};
+
+// ============================================================================
+// Internal Implementation
+// ============================================================================
+
+static long ms_since(const struct timespec *t) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - t->tv_sec) * 1000L + (now.tv_nsec - t->tv_nsec) / 1000000L;
+}
+
+static void handle_complete(XPresentCompleteNotifyEvent *ce) {
+    if (ce->kind != PresentCompleteKindPixmap) return;  // NotifyMSC - not ours
+
+    g_present_stats.completes++;
+    if (ce->mode == PresentCompleteModeSkip) {
+        g_present_stats.skipped++;
+    }
+
+    // Refresh estimate from the server's own clock (only when the MSC moved)
+    if (g_last_msc && ce->msc > g_last_msc && ce->ust > g_last_ust) {
+        uint64_t frames = ce->msc - g_last_msc;
+        if (frames > 1) g_present_stats.missed_vblanks += frames - 1;
+        g_present_stats.refresh_us_sum += (ce->ust - g_last_ust) / frames;
+        g_present_stats.refresh_samples++;
+    }
+    g_last_ust = ce->ust;
+    g_last_msc = ce->msc;
+
+    // Only the latest swap gates the next frame
+    if (ce->serial_number == g_present_serial) {
+        g_present_pending = false;
+        itn_render_frame_presented();
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+// Enable Present swaps to the given window (the compositor overlay)
+// Returns false if the extension is missing - caller keeps the XRender copy
+bool itn_present_init(Window window) {
+    Display *dpy = itn_core_get_display();
+    if (!dpy || window == None) return false;
+
+    int event_base, error_base;
+    if (!XPresentQueryExtension(dpy, &g_present_opcode, &event_base, &error_base)) {
+        log_error("[PRESENT] Present extension not available - using XRender copy");
+        return false;
+    }
+
+    int major = 1, minor = 0;
+    if (!XPresentQueryVersion(dpy, &major, &minor)) {
+        log_error("[PRESENT] Present version query failed - using XRender copy");
+        return false;
+    }
+
+    g_present_window = window;
+    g_present_eid = XPresentSelectInput(dpy, window, PresentCompleteNotifyMask);
+    g_present_serial = 0;
+    g_present_pending = false;
+    g_last_ust = 0;
+    g_last_msc = 0;
+    g_present_active = true;
+
+    log_error("[PRESENT] Present %d.%d swap backend enabled (vblank pacing)", major, minor);
+    return true;
+}
+
+void itn_present_cleanup(void) {
+    Display *dpy = itn_core_get_display();
+    if (dpy && g_present_eid != None) {
+        XPresentFreeInput(dpy, g_present_window, g_present_eid);
+    }
+    g_present_eid = None;
+    g_present_window = None;
+    g_present_pending = false;
+    g_present_active = false;
+}
+
+bool itn_present_is_active(void) {
+    return g_present_active;
+}
+
+// True while a swap is on its way to the screen - next frame must wait
+bool itn_present_is_pending(void) {
+    return g_present_active && g_present_pending;
+}
+
+// Present pixmap at the next vblank
+// update = region that changed (None = whole pixmap). Copy mode: the pixmap is
+// free for the next frame as soon as the server has read it.
+void itn_present_swap(Pixmap pixmap, XserverRegion update) {
+    Display *dpy = itn_core_get_display();
+    if (!dpy || !g_present_active || !pixmap) return;
+
+    g_present_serial++;
+    XPresentPixmap(dpy, g_present_window, pixmap, g_present_serial,
+                   None, update, 0, 0,
+                   None, None, None,          // Any CRTC, no fences
+                   PresentOptionCopy,
+                   0, 0, 0,                   // target_msc 0 = next vblank
+                   NULL, 0);
+
+    g_present_pending = true;
+    clock_gettime(CLOCK_MONOTONIC, &g_present_sent);
+    g_present_stats.presents++;
+}
+
+// Handle a GenericEvent - returns true if it was a Present event
+bool itn_present_handle_event(XEvent *event) {
+    if (!g_present_active || event->type != GenericEvent ||
+        event->xcookie.extension != g_present_opcode) {
+        return false;
+    }
+
+    Display *dpy = itn_core_get_display();
+    if (!dpy) return true;
+
+    XGenericEventCookie *cookie = &event->xcookie;
+    if (XGetEventData(dpy, cookie)) {
+        if (cookie->evtype == PresentCompleteNotify) {
+            handle_complete((XPresentCompleteNotifyEvent *)cookie->data);
+        }
+        XFreeEventData(dpy, cookie);
+    }
+    return true;
+}
+
+// Stop waiting for a completion that isn't coming (called from the frame timer)
+void itn_present_check_timeout(void) {
+    if (!g_present_pending) return;
+    if (ms_since(&g_present_sent) >= PRESENT_TIMEOUT_MS) {
+        g_present_pending = false;
+        g_present_stats.timeouts++;
+    }
+}
+
+// Watchdog delay for the frame timer while a completion is outstanding
+long itn_present_timeout_ns(void) {
+    return PRESENT_TIMEOUT_MS * 1000000L;
+}
+
+// Append Present statistics to the [METRICS] log and reset them
+void itn_present_log_metrics(void) {
+    if (!g_present_active) return;
+
+    log_error("[METRICS] Present Swaps:");
+    log_error("[METRICS]   Presents: %lu, completed: %lu, skipped: %lu",
+              g_present_stats.presents, g_present_stats.completes, g_present_stats.skipped);
+    log_error("[METRICS]   Missed vblanks: %lu, completion timeouts: %lu",
+              g_present_stats.missed_vblanks, g_present_stats.timeouts);
+    if (g_present_stats.refresh_samples > 0) {
+        double refresh_us = (double)g_present_stats.refresh_us_sum / g_present_stats.refresh_samples;
+        log_error("[METRICS]   Measured refresh: %.2f Hz (%.2f ms)",
+                  1000000.0 / refresh_us, refresh_us / 1000.0);
+    }
+
+    memset(&g_present_stats, 0, sizeof(g_present_stats));
+}
@@ -217,6 +217,7 @@ void intuition_handle_button_press(XButtonEvent *event);
 void intuition_handle_button_release(XButtonEvent *event);
 void intuition_handle_map_request(XMapRequestEvent *event);
 void intuition_handle_map_notify(XMapEvent *event);
+void intuition_handle_reparent_notify(XReparentEvent *event);
 void intuition_handle_unmap_notify(XUnmapEvent *event);
 void intuition_handle_configure_request(XConfigureRequestEvent *event);
 void intuition_handle_property_notify(XPropertyEvent *event);
@@ -247,6 +248,13 @@ void itn_render_accumulate_canvas_damage(Canvas *canvas);
 void itn_render_schedule_frame(void);
 void itn_render_update_metrics(int composite_calls, uint64_t pixels, int visible);
 
+// Frame trace (itn_trace.c) - NULL path writes ~/.config/amiwb/frametrace.json
+bool itn_trace_dump(const char *path);
+
+// Monitor rectangles in root coordinates (itn_outputs.c) - returns count
+#define MAX_OUTPUTS 8
+int itn_outputs_get_rects(XRectangle *rects, int max_rects);
+
 // --- Compositor ---
 void itn_composite_process_damage(XDamageNotifyEvent *event);
 bool itn_composite_remove_override(Window win);
@@ -18,11 +18,32 @@ static bool g_frame_scheduled = false;
 static int g_target_fps = 120;  // Default 120Hz
 bool g_continuous_mode = false;  // Default on-demand rendering
 
-// Damage accumulation state
-static bool damage_pending = false;
-static XRectangle damage_bounds = {0, 0, 0, 0};
+// Damage accumulation state - one list per output (monitor)
+// Disjoint rectangles, merged only when the union costs less than drawing both
+// (a tooltip top-left and a cursor blink bottom-right stay two small repaints)
+// Each output also has its own cadence from its refresh rate, so a 144Hz panel
+// next to a 60Hz one gets frames at 144Hz and 60Hz. Indexes match itn_outputs.c.
+typedef struct {
+    XRectangle bounds;
+    long interval_ns;
+    XRectangle damage_rects[MAX_DAMAGE_RECTS];
+    int damage_rect_count;
+    bool damage_pending;
+    struct timespec last_frame;
+    uint64_t frames;
+} OutputFrame;
+
+static OutputFrame g_out[MAX_OUTPUTS];
+static int g_out_count = 0;
+static int g_current_out = -1;       // Output being rendered by process_frame
+static bool damage_pending = false;  // Any output has damage
+static uint64_t g_damage_serial = 0; // Bumped by every damage that lands on an output
 static time_t last_frame_time = 0;
 
+// Outputs due within this much of their deadline render in the same pass
+// (keeps two 60Hz monitors from alternating timer wakeups)
+#define OUTPUT_SLACK_NS 1000000L
+
 // Performance metrics (migrated from old compositor)
 static struct {
     // Frame timing
@@ -35,9 +56,18 @@ static struct {
 
     // Render statistics
     uint64_t full_repaints;
+    uint64_t partial_repaints;
+    uint64_t pixels_repainted;     // Area of the repaint region (what gets swapped)
     uint64_t damage_events;
+    uint64_t pixmap_renames;       // XCompositeNameWindowPixmap + new Picture
     uint64_t frames_skipped;
     uint64_t composite_calls;
+    uint64_t frame_requests;       // X requests issued while rendering frames
+    unsigned long request_base;    // NextRequest() at snapshot start
+
+    // Input statistics
+    uint64_t motion_dispatched;    // MotionNotify events handed to handlers
+    uint64_t motion_coalesced;     // Stale MotionNotify events dropped in favour of newer ones
 
     // Window statistics
     int window_count;
@@ -56,32 +86,196 @@ static struct {
 
 // External references (temporary during migration)
 
+// Helper: Area of a rectangle given by its edges
+static inline uint64_t rect_area(int x1, int y1, int x2, int y2) {
+    return (uint64_t)(x2 - x1) * (uint64_t)(y2 - y1);
+}
+
+// Helper: Grow rectangle *r to also cover (x1,y1)-(x2,y2)
+static void rect_union(XRectangle *r, int x1, int y1, int x2, int y2) {
+    int rx2 = max(r->x + r->width, x2);
+    int ry2 = max(r->y + r->height, y2);
+    r->x = min(r->x, x1);
+    r->y = min(r->y, y1);
+    r->width = rx2 - r->x;
+    r->height = ry2 - r->y;
+}
+
+// Helper: Extra pixels the union of r and (x1,y1)-(x2,y2) costs over drawing both
+// Negative or zero means merging is cheaper (they overlap or touch)
+static int64_t merge_cost(const XRectangle *r, int x1, int y1, int x2, int y2) {
+    int ux1 = min(r->x, x1), uy1 = min(r->y, y1);
+    int ux2 = max(r->x + r->width, x2), uy2 = max(r->y + r->height, y2);
+    return (int64_t)rect_area(ux1, uy1, ux2, uy2) -
+           (int64_t)rect_area(r->x, r->y, r->x + r->width, r->y + r->height) -
+           (int64_t)rect_area(x1, y1, x2, y2);
+}
+
+static long ns_between(const struct timespec *a, const struct timespec *b) {
+    return (b->tv_sec - a->tv_sec) * 1000000000L + (b->tv_nsec - a->tv_nsec);
+}
+
+// Frame interval for an output: its refresh rate, capped by target_fps
+// (outputs XRandR can't give a rate for just use target_fps)
+static long output_interval_ns(const ItnOutput *info) {
+    double hz = g_target_fps;
+    if (info && info->refresh_hz > 1.0 && info->refresh_hz < hz) {
+        hz = info->refresh_hz;
+    }
+    return (long)(1000000000.0 / hz);
+}
+
+// Rebuild per-output state from itn_outputs (drops pending damage)
+static void sync_outputs(void) {
+    itn_outputs_refresh();
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    g_out_count = min(itn_outputs_count(), MAX_OUTPUTS);
+    for (int i = 0; i < g_out_count; i++) {
+        const ItnOutput *info = itn_outputs_get(i);
+        memset(&g_out[i], 0, sizeof(g_out[i]));
+        g_out[i].bounds = info->rect;
+        g_out[i].interval_ns = output_interval_ns(info);
+        g_out[i].last_frame = now;
+    }
+    g_current_out = -1;
+    damage_pending = false;
+}
+
+// Add damage to one output's list (rect already clipped to the output)
+static void output_add_damage(OutputFrame *o, int x1, int y1, int x2, int y2) {
+    o->damage_pending = true;
+    XRectangle *damage_rects = o->damage_rects;
+
+    // Merge with every rectangle where the union is cheaper than keeping both
+    // Merging grows the new rect, which may make further merges cheaper - so rescan
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (int i = 0; i < o->damage_rect_count; i++) {
+            XRectangle *r = &damage_rects[i];
+            if (merge_cost(r, x1, y1, x2, y2) > 0) continue;
+
+            // Absorb r into the new rect and drop it from the list
+            x1 = min(x1, r->x);
+            y1 = min(y1, r->y);
+            x2 = max(x2, r->x + r->width);
+            y2 = max(y2, r->y + r->height);
+            damage_rects[i] = damage_rects[--o->damage_rect_count];
+            merged = true;
+            break;
+        }
+    }
+
+    if (o->damage_rect_count < MAX_DAMAGE_RECTS) {
+        damage_rects[o->damage_rect_count++] = (XRectangle){x1, y1, x2 - x1, y2 - y1};
+        return;
+    }
+
+    // List full - fold into the rectangle where it wastes the fewest pixels
+    int best = 0;
+    int64_t best_cost = merge_cost(&damage_rects[0], x1, y1, x2, y2);
+    for (int i = 1; i < o->damage_rect_count; i++) {
+        int64_t cost = merge_cost(&damage_rects[i], x1, y1, x2, y2);
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = i;
+        }
+    }
+    rect_union(&damage_rects[best], x1, y1, x2, y2);
+}
+
 void itn_render_accumulate_damage(int x, int y, int width, int height) {
     if (width <= 0 || height <= 0) return;
 
-    if (!damage_pending) {
-        // First damage - initialize bounds
-        damage_bounds.x = x;
-        damage_bounds.y = y;
-        damage_bounds.width = width;
-        damage_bounds.height = height;
+    // Damage can arrive before the frame scheduler starts (back buffer setup)
+    if (g_out_count == 0) sync_outputs();
+
+    // Split across outputs - parts no monitor shows are dropped
+    bool landed = false;
+    for (int i = 0; i < g_out_count; i++) {
+        const XRectangle *b = &g_out[i].bounds;
+        int x1 = max(x, b->x), y1 = max(y, b->y);
+        int x2 = min(x + width, b->x + b->width), y2 = min(y + height, b->y + b->height);
+        if (x2 <= x1 || y2 <= y1) continue;
+        output_add_damage(&g_out[i], x1, y1, x2, y2);
         damage_pending = true;
+        landed = true;
+    }
+    if (landed) g_damage_serial++;
+}
+
+// Changes whenever new damage arrives - lets input tracing tell whether an
+// event handler caused anything to be drawn
+uint64_t itn_render_damage_serial(void) {
+    return g_damage_serial;
+}
+
+// Get the damage rectangles of the output being rendered
+// Returns 0 when nothing is damaged (caller decides whether to repaint everything)
+int itn_render_get_damage_rects(const XRectangle **rects) {
+    int i = g_current_out >= 0 ? g_current_out : 0;
+    if (i >= g_out_count) {
+        if (rects) *rects = NULL;
+        return 0;
+    }
+    if (rects) *rects = g_out[i].damage_rects;
+    return g_out[i].damage_pending ? g_out[i].damage_rect_count : 0;
+}
+
+// Bounds of the output being rendered ("repaint everything" means this)
+void itn_render_get_output_bounds(XRectangle *bounds) {
+    int i = g_current_out >= 0 ? g_current_out : 0;
+    if (i < g_out_count) {
+        *bounds = g_out[i].bounds;
     } else {
-        // Expand bounds to include new damage
-        int right = max(damage_bounds.x + damage_bounds.width, x + width);
-        int bottom = max(damage_bounds.y + damage_bounds.height, y + height);
-        damage_bounds.x = min(damage_bounds.x, x);
-        damage_bounds.y = min(damage_bounds.y, y);
-        damage_bounds.width = right - damage_bounds.x;
-        damage_bounds.height = bottom - damage_bounds.y;
+        *bounds = (XRectangle){0, 0, itn_core_get_screen_width(), itn_core_get_screen_height()};
     }
 }
 
+// Outputs changed (XRandR) - re-read them and repaint everything
+void itn_render_outputs_changed(void) {
+    sync_outputs();
+    itn_render_accumulate_damage(0, 0, itn_core_get_screen_width(), itn_core_get_screen_height());
+    SCHEDULE_FRAME();
+}
+
 void itn_render_accumulate_canvas_damage(Canvas *canvas) {
     if (!canvas) return;
     itn_render_accumulate_damage(canvas->x, canvas->y, canvas->width, canvas->height);
 }
 
+// Time until an output should get its next frame
+static long output_delay_ns(const OutputFrame *o, const struct timespec *now) {
+    long frame_interval_ns = o->interval_ns;
+    long elapsed_ns = ns_between(&o->last_frame, now);
+
+    if (itn_present_is_active() && elapsed_ns >= frame_interval_ns) {
+        // Vblank already paces swaps - no need to hold back a full interval
+        return 100000;
+    } else if (g_continuous_mode && !itn_present_is_active()) {
+        // In continuous mode, ALWAYS use full frame interval to ensure
+        // X11 input events get processed between frames
+        // Never use minimal delay - that starves the event loop
+        return max(frame_interval_ns - elapsed_ns, 100000L);
+    } else if (elapsed_ns < frame_interval_ns) {
+        // On-demand mode: wait for remainder of frame interval
+        return frame_interval_ns - elapsed_ns;
+    }
+    // On-demand mode: render immediately with minimal delay
+    // Use 100 microseconds (0.1ms) for near-immediate response
+    return 100000;  // 0.1ms - prevents CPU spinning while being responsive
+}
+
+// Output's turn to render (within OUTPUT_SLACK_NS of its deadline)
+static bool output_due(const OutputFrame *o, const struct timespec *now) {
+    if (!g_continuous_mode && !o->damage_pending) return false;
+    if (itn_present_is_active()) return true;  // Vblank paces instead
+    return ns_between(&o->last_frame, now) + OUTPUT_SLACK_NS >= o->interval_ns;
+}
+
 void itn_render_schedule_frame(void) {
     // Don't schedule if we're already scheduled or no timer
     if (g_frame_scheduled) {
@@ -98,31 +292,25 @@ void itn_render_schedule_frame(void) {
         return;
     }
 
-    // Calculate time since last frame
+    if (g_out_count == 0) sync_outputs();
+
     struct timespec now;
     clock_gettime(CLOCK_MONOTONIC, &now);
 
-    // Calculate minimum frame interval in nanoseconds (e.g., 8.33ms for 120Hz)
-    long frame_interval_ns = 1000000000L / g_target_fps;
-
-    // Calculate time elapsed since last frame
-    long elapsed_ns = (now.tv_sec - metrics.last_frame_time.tv_sec) * 1000000000L +
-                     (now.tv_nsec - metrics.last_frame_time.tv_nsec);
-
-    // Calculate delay to next frame
+    // One timer for all outputs: armed for whichever is due first
     long delay_ns;
-    if (g_continuous_mode) {
-        // In continuous mode, ALWAYS use full frame interval to ensure
-        // X11 input events get processed between frames
-        // Never use minimal delay - that starves the event loop
-        delay_ns = frame_interval_ns;
-    } else if (elapsed_ns < frame_interval_ns) {
-        // On-demand mode: wait for remainder of frame interval
-        delay_ns = frame_interval_ns - elapsed_ns;
+    if (itn_present_is_pending()) {
+        // Present backend: the next frame starts from PresentCompleteNotify
+        // (itn_render_frame_presented). Timer is only a watchdog meanwhile.
+        delay_ns = itn_present_timeout_ns();
     } else {
-        // On-demand mode: render immediately with minimal delay
-        // Use 100 microseconds (0.1ms) for near-immediate response
-        delay_ns = 100000;  // 0.1ms - prevents CPU spinning while being responsive
+        delay_ns = -1;
+        for (int i = 0; i < g_out_count; i++) {
+            if (!g_continuous_mode && !g_out[i].damage_pending) continue;
+            long d = output_delay_ns(&g_out[i], &now);
+            if (delay_ns < 0 || d < delay_ns) delay_ns = d;
+        }
+        if (delay_ns < 0) return;  // Damage only outside every output
     }
 
     // Set timer for next frame
@@ -140,6 +328,9 @@ void itn_render_schedule_frame(void) {
 }
 
 void itn_render_process_frame(void) {
+    // Interactive resize applies its latest geometry once per frame
+    itn_resize_flush_frame();
+
     // In on-demand mode, skip if no damage
     // In continuous mode, always render
     if (!g_continuous_mode && !damage_pending) {
@@ -148,20 +339,56 @@ void itn_render_process_frame(void) {
         return;
     }
 
+    // Previous swap not on screen yet - keep damage, completion restarts us
+    if (itn_present_is_pending()) {
+        return;
+    }
+
     // Start frame timing
     struct timespec frame_start;
     clock_gettime(CLOCK_MONOTONIC, &frame_start);
 
+    // Which outputs are due? Timer fired for the earliest - others may wait
+    bool due[MAX_OUTPUTS];
+    int due_count = 0;
+    for (int i = 0; i < g_out_count; i++) {
+        due[i] = output_due(&g_out[i], &frame_start);
+        if (due[i]) due_count++;
+    }
+    if (due_count == 0) {
+        if (g_continuous_mode && !itn_present_is_active()) itn_render_schedule_frame();
+        return;
+    }
+
     metrics.frame_count++;
-    metrics.full_repaints++;  // Currently always full repaint
+    itn_trace_frame_begin();
 
-    // If compositor is active, use it
-    if (itn_composite_is_active()) {
-        itn_composite_render_all();
-    } else {
-        // Fallback: render damaged canvases using legacy path
-        itn_render_damaged_canvases();
+    // Request sequence numbers count every X request we queue
+    Display *dpy = itn_core_get_display();
+    unsigned long first_request = dpy ? NextRequest(dpy) : 0;
+
+    // Fallback without compositor: render damaged canvases using legacy path
+    // Once per frame - a canvas spanning two outputs is drawn only once
+    bool compositing = itn_composite_is_active();
+    if (!compositing) itn_render_damaged_canvases(due);
+
+    // One pass per due output - each repaints only its own region
+    for (int i = 0; i < g_out_count; i++) {
+        if (!due[i]) continue;
+        g_current_out = i;
+
+        if (compositing) itn_composite_render_all();
+
+        // Clear this output's damage for its next frame
+        g_out[i].damage_pending = false;
+        g_out[i].damage_rect_count = 0;
+        g_out[i].last_frame = frame_start;
+        g_out[i].frames++;
+
+        // Present swaps the whole overlay - the rest wait for its completion
+        if (itn_present_is_pending()) break;
     }
+    g_current_out = -1;
 
     // End frame timing
     struct timespec frame_end;
@@ -176,10 +403,14 @@ void itn_render_process_frame(void) {
         metrics.worst_frame_time_ms = frame_time_ms;
     }
     metrics.last_frame_time = frame_end;
+    if (dpy) metrics.frame_requests += NextRequest(dpy) - first_request;
+    itn_trace_frame_end();
 
-    // Clear damage for next frame
+    // Outputs that weren't due keep their damage
     damage_pending = false;
-    damage_bounds = (XRectangle){0, 0, 0, 0};
+    for (int i = 0; i < g_out_count; i++) {
+        if (g_out[i].damage_pending) damage_pending = true;
+    }
 
     // DON'T clear g_frame_scheduled here! It will be cleared when timer expires
     // This prevents immediate re-scheduling
@@ -189,27 +420,52 @@ void itn_render_process_frame(void) {
 
     // In continuous mode, schedule next frame AFTER processing current one
     // This allows X11 events to be handled between frames
-    if (g_continuous_mode) {
+    // (With Present the completion event does this instead)
+    if ((g_continuous_mode || damage_pending) && !itn_present_is_active()) {
+        itn_render_schedule_frame();
+    }
+}
+
+// Last swap reached the screen (PresentCompleteNotify) - start the next frame
+// if anything is waiting for one
+void itn_render_frame_presented(void) {
+    if (g_continuous_mode || damage_pending) {
+        // Re-arm: timerfd_settime replaces the pending watchdog
+        g_frame_scheduled = false;
         itn_render_schedule_frame();
     }
 }
 
+// Does the canvas intersect any damage rectangle of this output?
+static bool canvas_hits_output_damage(const Canvas *canvas, const OutputFrame *o) {
+    if (!o->damage_pending) return false;
+    for (int r = 0; r < o->damage_rect_count; r++) {
+        const XRectangle *d = &o->damage_rects[r];
+        if (canvas->x < d->x + d->width &&
+            canvas->x + canvas->width > d->x &&
+            canvas->y < d->y + d->height &&
+            canvas->y + canvas->height > d->y) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // Render canvases that have damage (fallback for non-compositor mode)
-void itn_render_damaged_canvases(void) {
-    // Find canvases that intersect with damage bounds
+// Looks at the damage of every due output, so each canvas is drawn once
+void itn_render_damaged_canvases(const bool *due) {
     int count = itn_manager_get_count();
     for (int i = 0; i < count; i++) {
         Canvas *canvas = itn_manager_get_canvas(i);
         if (!canvas) continue;
 
-        // Check if canvas intersects with damage bounds
-        if (canvas->x < damage_bounds.x + damage_bounds.width &&
-            canvas->x + canvas->width > damage_bounds.x &&
-            canvas->y < damage_bounds.y + damage_bounds.height &&
-            canvas->y + canvas->height > damage_bounds.y) {
-
-            // Use legacy render path from render.c
-            redraw_canvas(canvas);
+        for (int o = 0; o < g_out_count; o++) {
+            if (due && !due[o]) continue;
+            if (canvas_hits_output_damage(canvas, &g_out[o])) {
+                // Use legacy render path from render.c
+                redraw_canvas(canvas);
+                break;  // Once per canvas, however many outputs/rects hit it
+            }
         }
     }
 }
@@ -232,6 +488,9 @@ void itn_render_consume_timer(void) {
         // Clear the scheduled flag - now new frames can be scheduled
         g_frame_scheduled = false;
 
+        // Watchdog: don't wait forever for a lost PresentCompleteNotify
+        itn_present_check_timeout();
+
         // DON'T re-schedule here in continuous mode!
         // This creates a tight loop that starves X11 event processing.
         // Only schedule if we have pending damage in on-demand mode.
@@ -245,6 +504,9 @@ void itn_render_consume_timer(void) {
 void itn_render_set_target_fps(int fps) {
     if (fps > 0 && fps <= 240) {  // Reasonable limits
         g_target_fps = fps;
+        for (int i = 0; i < g_out_count; i++) {
+            g_out[i].interval_ns = output_interval_ns(itn_outputs_get(i));
+        }
     }
 }
 
@@ -284,9 +546,17 @@ bool itn_render_init_frame_scheduler(void) {
     g_continuous_mode = (config->render_mode == 1);
     log_error("[RENDER] Render mode: %s", g_continuous_mode ? "CONTINUOUS" : "ON-DEMAND");
 
+    // Per-output cadence needs target_fps, so outputs are (re)read after it
+    // (damage queued before this point is dropped - repaint everything)
+    sync_outputs();
+    itn_render_accumulate_damage(0, 0, itn_core_get_screen_width(), itn_core_get_screen_height());
+
     // Initialize metrics timestamps
     clock_gettime(CLOCK_MONOTONIC, &metrics.last_frame_time);
     clock_gettime(CLOCK_MONOTONIC, &metrics.metrics_start_time);
+    if (itn_core_get_display()) {
+        metrics.request_base = NextRequest(itn_core_get_display());
+    }
 
     // In continuous mode, kick off the first frame
     if (g_continuous_mode) {
@@ -350,6 +620,27 @@ void itn_render_update_metrics(int composite_calls, uint64_t pixels, int visible
     }
 }
 
+// Record the size of the region the compositor repainted this frame
+void itn_render_record_repaint(bool full, uint64_t pixels) {
+    if (full) {
+        metrics.full_repaints++;
+    } else {
+        metrics.partial_repaints++;
+    }
+    metrics.pixels_repainted += pixels;
+}
+
+// Record a named pixmap re-creation (should only follow map/resize/reparent)
+void itn_render_record_pixmap_rename(void) {
+    metrics.pixmap_renames++;
+}
+
+// Record one dispatched MotionNotify and how many queued ones it replaced
+void itn_render_record_motion(int coalesced) {
+    metrics.motion_dispatched++;
+    metrics.motion_coalesced += coalesced;
+}
+
 // Log performance metrics (migrated from old compositor)
 void itn_render_log_metrics(void) {
     if (metrics.frame_count == 0) {
@@ -381,7 +672,9 @@ void itn_render_log_metrics(void) {
 
     log_error("[METRICS] Render Statistics:");
     log_error("[METRICS]   Full repaints: %lu", metrics.full_repaints);
+    log_error("[METRICS]   Partial repaints: %lu", metrics.partial_repaints);
     log_error("[METRICS]   Damage events: %lu", metrics.damage_events);
+    log_error("[METRICS]   Pixmap re-names: %lu", metrics.pixmap_renames);
     if (metrics.frame_count > 0) {
         log_error("[METRICS]   Damage events per frame: %.1f",
                   (double)metrics.damage_events / metrics.frame_count);
@@ -394,10 +687,43 @@ void itn_render_log_metrics(void) {
                   (double)metrics.composite_calls / metrics.frame_count);
     }
 
+    Display *dpy = itn_core_get_display();
+    if (dpy) {
+        log_error("[METRICS] X Protocol:");
+        log_error("[METRICS]   Requests issued: %lu (%lu while rendering frames)",
+                  NextRequest(dpy) - metrics.request_base, metrics.frame_requests);
+        log_error("[METRICS]   Requests per frame: %.1f",
+                  (double)metrics.frame_requests / metrics.frame_count);
+    }
+
     log_error("[METRICS] Window Statistics:");
     log_error("[METRICS]   Windows tracked: %d", itn_manager_get_count());
     log_error("[METRICS]   Visible windows: %d", metrics.visible_windows);
 
+    if (metrics.motion_dispatched > 0) {
+        uint64_t motion_total = metrics.motion_dispatched + metrics.motion_coalesced;
+        log_error("[METRICS] Input Statistics:");
+        log_error("[METRICS]   Motion events dispatched: %lu", metrics.motion_dispatched);
+        log_error("[METRICS]   Motion events coalesced: %lu (%.1f%%)", metrics.motion_coalesced,
+                  (100.0 * metrics.motion_coalesced) / motion_total);
+    }
+
+    // Per-output cadence (frames counts every pass that repainted the output)
+    if (g_out_count > 1) {
+        double elapsed_s = time_diff_ms(&metrics.metrics_start_time, &now) / 1000.0;
+        log_error("[METRICS] Outputs:");
+        for (int i = 0; i < g_out_count; i++) {
+            const ItnOutput *info = itn_outputs_get(i);
+            OutputFrame *o = &g_out[i];
+            log_error("[METRICS]   %s %dx%d+%d+%d: %lu frames (%.1f/s), target %.1f Hz",
+                      info ? info->name : "?", o->bounds.width, o->bounds.height,
+                      o->bounds.x, o->bounds.y, o->frames,
+                      elapsed_s > 0 ? o->frames / elapsed_s : 0.0,
+                      1000000000.0 / o->interval_ns);
+            o->frames = 0;
+        }
+    }
+
     // Repaint reason breakdown
     if (metrics.repaints_damage + metrics.repaints_configure + metrics.repaints_map > 0) {
         log_error("[METRICS] Repaint Triggers:");
@@ -415,10 +741,14 @@ void itn_render_log_metrics(void) {
     if (metrics.pixels_actually_drawn > 0) {
         log_error("[METRICS] Pixel Efficiency:");
         double megapixels_drawn = metrics.pixels_actually_drawn / 1000000.0;
+        double megapixels_swapped = metrics.pixels_repainted / 1000000.0;
         log_error("[METRICS]   Total megapixels drawn: %.1f", megapixels_drawn);
+        log_error("[METRICS]   Total megapixels swapped: %.1f", megapixels_swapped);
         if (metrics.frame_count > 0) {
             log_error("[METRICS]   Megapixels per frame: %.2f",
                       megapixels_drawn / metrics.frame_count);
+            log_error("[METRICS]   Swapped megapixels per frame: %.2f",
+                      megapixels_swapped / metrics.frame_count);
         }
     }
 
@@ -446,6 +776,10 @@ void itn_render_log_metrics(void) {
                   cpu_percent, metrics.total_frame_time_ms, total_elapsed_ms);
     }
 
+    itn_present_log_metrics();
+    itn_shm_log_metrics();
+    itn_trace_log_metrics();
+
     log_error("[METRICS] =============================");
 
     // Reset metrics for next interval
@@ -453,4 +787,5 @@ void itn_render_log_metrics(void) {
     metrics.start_time = time(NULL);
     clock_gettime(CLOCK_MONOTONIC, &metrics.metrics_start_time);
     metrics.last_frame_time = metrics.metrics_start_time;
+    if (dpy) metrics.request_base = NextRequest(dpy);
 }
\ No newline at end of file
@@ -1,10 +1,21 @@
 // Window resizing
 // This module handles interactive window resizing
+// Motion only records the wanted geometry. Once per frame (itn_resize_flush_frame,
+// from the frame scheduler) the frame window follows it - decorations are drawn
+// into the oversized buffer_width/buffer_height backing, so that's cheap.
+// Clients (GTK/Qt re-layout on every configure) get a new size only after they
+// repainted the previous one, or after RESIZE_CLIENT_TIMEOUT_MS. Until then the
+// compositor stretches their last content over the new content area.
 
 #include "../config.h"
 #include "itn_internal.h"
+#include "../render/rnd_public.h"
 #include "../workbench/wb_spatial.h"
 #include <X11/Xlib.h>
+#include <time.h>
+
+// Client that hasn't repainted after this long gets the next size anyway
+#define RESIZE_CLIENT_TIMEOUT_MS 100
 
 // Resize state
 static Canvas *resize_target = NULL;
@@ -16,6 +27,93 @@ static int resize_orig_y = 0;
 static int resize_orig_width = 0;
 static int resize_orig_height = 0;
 
+// Geometry wanted by the pointer, applied at the next frame
+static bool geometry_pending = false;
+static int pending_x = 0, pending_y = 0;
+static int pending_width = 0, pending_height = 0;
+
+// Client pacing: size last sent, and whether the client has drawn it yet
+static int client_width = 0;
+static int client_height = 0;
+static bool client_caught_up = true;
+static struct timespec client_configure_time = {0, 0};
+
+// ============================================================================
+// Internal Implementation
+// ============================================================================
+
+static long ms_since(const struct timespec *then) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - then->tv_sec) * 1000L + (now.tv_nsec - then->tv_nsec) / 1000000L;
+}
+
+static void send_client_size(Canvas *canvas) {
+    itn_geometry_configure_client(canvas, &client_width, &client_height);
+    client_caught_up = false;
+    clock_gettime(CLOCK_MONOTONIC, &client_configure_time);
+}
+
+// Apply pending frame geometry and, if the client is ready, its new size
+static void apply_pending(bool final) {
+    Canvas *c = resize_target;
+    if (geometry_pending) {
+        geometry_pending = false;
+        if (pending_x != c->x || pending_y != c->y ||
+            pending_width != c->width || pending_height != c->height) {
+            itn_geometry_move_resize(c, pending_x, pending_y, pending_width, pending_height);
+        }
+    }
+
+    if (c->client_win == None) return;
+
+    int want_w, want_h;
+    itn_decorations_get_content_area(c, NULL, NULL, &want_w, &want_h);
+    if (want_w == client_width && want_h == client_height) return;
+
+    if (final || client_caught_up || ms_since(&client_configure_time) >= RESIZE_CLIENT_TIMEOUT_MS) {
+        send_client_size(c);
+    } else {
+        // Keep frames coming until the client catches up or times out
+        // (scheduling needs damage - the stretched client is redrawn anyway)
+        DAMAGE_CANVAS(c);
+        SCHEDULE_FRAME();
+    }
+}
+
+// Leave interactive mode: real surfaces for the final size, final client size
+static void end_resize(void) {
+    Canvas *c = resize_target;
+    apply_pending(true);
+
+    c->resizing_interactive = false;
+    render_recreate_canvas_surfaces(c);
+
+    // Final update with pixmap recreation
+    if (c->comp_pixmap) {
+        itn_composite_update_canvas_pixmap(c);
+    }
+    redraw_canvas(c);
+    DAMAGE_CANVAS(c);
+    SCHEDULE_FRAME();
+
+    // Release pointer grab
+    Display *dpy = itn_core_get_display();
+    if (dpy) {
+        XUngrabPointer(dpy, CurrentTime);
+    }
+
+    // Clear resize state
+    resize_target = NULL;
+    resize_corner = 0;
+    geometry_pending = false;
+    client_caught_up = true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
 void itn_resize_start(Canvas *canvas, int corner) {
     if (!canvas || resize_target) return;
 
@@ -28,6 +126,14 @@ void itn_resize_start(Canvas *canvas, int corner) {
     resize_orig_width = canvas->width;
     resize_orig_height = canvas->height;
 
+    // Decorations draw into the (oversized) buffer until release
+    canvas->resizing_interactive = true;
+    geometry_pending = false;
+    client_caught_up = true;
+    if (canvas->client_win != None) {
+        itn_decorations_get_content_area(canvas, NULL, NULL, &client_width, &client_height);
+    }
+
     // Get current pointer position
     Display *dpy = itn_core_get_display();
     if (dpy) {
@@ -129,56 +235,88 @@ void itn_resize_continue(int x, int y) {
         new_height = resize_target->max_height;
     }
 
-    // Apply new geometry
-    if (new_x != resize_target->x || new_y != resize_target->y ||
-        new_width != resize_target->width || new_height != resize_target->height) {
-        itn_geometry_move_resize(resize_target, new_x, new_y, new_width, new_height);
+    // Record new geometry - applied once per frame (itn_resize_flush_frame)
+    pending_x = new_x;
+    pending_y = new_y;
+    pending_width = new_width;
+    pending_height = new_height;
+    geometry_pending = true;
+
+    // Scheduling needs damage - the old area gets repainted anyway
+    DAMAGE_CANVAS(resize_target);
+    SCHEDULE_FRAME();
+}
+
+// Called by the frame scheduler before rendering - at most one frame
+// reconfigure and one client configure per frame
+void itn_resize_flush_frame(void) {
+    if (!resize_target) return;
+    apply_pending(false);
+}
+
+// Client window repainted (XDamage) at drawn_width x drawn_height
+// Only damage at the size last sent counts as caught up - events queued
+// before the configure still carry the old size
+void itn_resize_client_damaged(Canvas *canvas, int drawn_width, int drawn_height) {
+    if (canvas && canvas == resize_target &&
+        drawn_width == client_width && drawn_height == client_height) {
+        client_caught_up = true;
     }
 }
 
+// Is the client still showing an older size than the frame's content area?
+// Returns the client's size so the compositor can stretch it meanwhile
+bool itn_resize_client_lag(Canvas *canvas, int *out_width, int *out_height) {
+    if (!canvas || canvas != resize_target || canvas->client_win == None) return false;
+
+    int want_w, want_h;
+    itn_decorations_get_content_area(canvas, NULL, NULL, &want_w, &want_h);
+    if (client_width >= want_w && client_height >= want_h) return false;  // Shrinking just crops
+
+    if (out_width) *out_width = client_width;
+    if (out_height) *out_height = client_height;
+    return true;
+}
+
 void itn_resize_finish(void) {
     if (!resize_target) return;
 
-    // Final update with pixmap recreation
-    if (resize_target->comp_pixmap) {
-        itn_composite_update_canvas_pixmap(resize_target);
-    }
+    Canvas *canvas = resize_target;
+    end_resize();
 
     // Save window geometry for spatial mode (workbench windows only)
-    if (resize_target->type == WINDOW && resize_target->path) {
-        wb_spatial_save_geometry(resize_target->path,
-                                resize_target->x, resize_target->y,
-                                resize_target->width, resize_target->height);
+    if (canvas->type == WINDOW && canvas->path) {
+        wb_spatial_save_geometry(canvas->path,
+                                canvas->x, canvas->y,
+                                canvas->width, canvas->height);
     }
-
-    // Release pointer grab
-    Display *dpy = itn_core_get_display();
-    if (dpy) {
-        XUngrabPointer(dpy, CurrentTime);
-    }
-
-    // Clear resize state
-    resize_target = NULL;
-    resize_corner = 0;
 }
 
 void itn_resize_cancel(void) {
     if (!resize_target) return;
 
     // Restore original geometry
-    itn_geometry_move_resize(resize_target,
-                            resize_orig_x, resize_orig_y,
-                            resize_orig_width, resize_orig_height);
+    pending_x = resize_orig_x;
+    pending_y = resize_orig_y;
+    pending_width = resize_orig_width;
+    pending_height = resize_orig_height;
+    geometry_pending = true;
+
+    end_resize();
+}
+
+// Target is being destroyed mid-resize - drop the state without touching it
+void itn_resize_canvas_destroyed(Canvas *canvas) {
+    if (!canvas || canvas != resize_target) return;
 
-    // Release pointer grab
     Display *dpy = itn_core_get_display();
     if (dpy) {
         XUngrabPointer(dpy, CurrentTime);
     }
-
-    // Clear resize state
     resize_target = NULL;
     resize_corner = 0;
+    geometry_pending = false;
+    client_caught_up = true;
 }
 
 bool itn_resize_is_active(void) {
@@ -109,9 +109,10 @@ static bool handle_scrollbar_click(Canvas *canvas, XButtonEvent *event, bool is_
         // Click on track - jump to that position
         int track_start = is_vertical ? track_y : track_x;
         int new_scroll = calculate_scroll_from_mouse_click(track_start, track_length, max_scroll, click_coordinate);
+        int old_scroll_x = canvas->scroll_x, old_scroll_y = canvas->scroll_y;
         if (is_vertical) canvas->scroll_y = new_scroll;
         else canvas->scroll_x = new_scroll;
-        redraw_canvas(canvas);  // Follow same pattern as arrow buttons and knob drag
+        render_scroll_canvas(canvas, old_scroll_x, old_scroll_y);  // Blit + exposed strip
         DAMAGE_CANVAS(canvas);
         SCHEDULE_FRAME();
     }
@@ -129,6 +130,7 @@ static bool handle_arrow_scroll_repeat(void) {
 
         if (new_scroll != current_scroll) {
             arrow_scroll_canvas->scroll_y = new_scroll;
+            render_scroll_canvas(arrow_scroll_canvas, arrow_scroll_canvas->scroll_x, current_scroll);
             DAMAGE_CANVAS(arrow_scroll_canvas);
             SCHEDULE_FRAME();
             return true;
@@ -140,6 +142,7 @@ static bool handle_arrow_scroll_repeat(void) {
 
         if (new_scroll != current_scroll) {
             arrow_scroll_canvas->scroll_x = new_scroll;
+            render_scroll_canvas(arrow_scroll_canvas, current_scroll, arrow_scroll_canvas->scroll_y);
             DAMAGE_CANVAS(arrow_scroll_canvas);
             SCHEDULE_FRAME();
             return true;
@@ -168,6 +171,8 @@ bool itn_scrollbar_handle_button_press(Canvas *canvas, XButtonEvent *event) {
     int y = event->y;
     int w = canvas->width;
     int h = canvas->height;
+    int old_scroll_x = canvas->scroll_x;
+    int old_scroll_y = canvas->scroll_y;
 
     // Check vertical scroll arrows (on right border) FIRST
     if (x >= w - BORDER_WIDTH_RIGHT && x < w) {
@@ -183,7 +188,7 @@ bool itn_scrollbar_handle_button_press(Canvas *canvas, XButtonEvent *event) {
             if (canvas->scroll_y > 0) {
                 canvas->scroll_y = max(0, canvas->scroll_y - SCROLL_STEP);
             }
-            redraw_canvas(canvas);
+            render_scroll_canvas(canvas, old_scroll_x, old_scroll_y);
             DAMAGE_CANVAS(canvas);
             SCHEDULE_FRAME();
             return true;
@@ -200,7 +205,7 @@ bool itn_scrollbar_handle_button_press(Canvas *canvas, XButtonEvent *event) {
             if (canvas->scroll_y < canvas->max_scroll_y) {
                 canvas->scroll_y = min(canvas->max_scroll_y, canvas->scroll_y + SCROLL_STEP);
             }
-            redraw_canvas(canvas);
+            render_scroll_canvas(canvas, old_scroll_x, old_scroll_y);
             DAMAGE_CANVAS(canvas);
             SCHEDULE_FRAME();
             return true;
@@ -221,7 +226,7 @@ bool itn_scrollbar_handle_button_press(Canvas *canvas, XButtonEvent *event) {
             if (canvas->scroll_x > 0) {
                 canvas->scroll_x = max(0, canvas->scroll_x - SCROLL_STEP);
             }
-            redraw_canvas(canvas);
+            render_scroll_canvas(canvas, old_scroll_x, old_scroll_y);
             DAMAGE_CANVAS(canvas);
             SCHEDULE_FRAME();
             return true;
@@ -238,7 +243,7 @@ bool itn_scrollbar_handle_button_press(Canvas *canvas, XButtonEvent *event) {
             if (canvas->scroll_x < canvas->max_scroll_x) {
                 canvas->scroll_x = min(canvas->max_scroll_x, canvas->scroll_x + SCROLL_STEP);
             }
-            redraw_canvas(canvas);
+            render_scroll_canvas(canvas, old_scroll_x, old_scroll_y);
             DAMAGE_CANVAS(canvas);
             SCHEDULE_FRAME();
             return true;
@@ -263,6 +268,8 @@ bool itn_scrollbar_handle_button_press(Canvas *canvas, XButtonEvent *event) {
 // Returns true if event was consumed, false otherwise
 bool itn_scrollbar_handle_button_release(Canvas *canvas, XButtonEvent *event) {
     bool consumed = false;
+    int old_scroll_x = canvas->scroll_x;
+    int old_scroll_y = canvas->scroll_y;
 
     // Clear arrow armed states and perform final scroll if still on button
     if (canvas->v_arrow_up_armed) {
@@ -275,7 +282,9 @@ bool itn_scrollbar_handle_button_release(Canvas *canvas, XButtonEvent *event) {
                 canvas->scroll_y = max(0, canvas->scroll_y - SCROLL_STEP);
             }
         }
-        redraw_canvas(canvas);
+        render_scroll_canvas(canvas, old_scroll_x, old_scroll_y);
+        old_scroll_x = canvas->scroll_x;  // Pixels are current now
+        old_scroll_y = canvas->scroll_y;
         DAMAGE_CANVAS(canvas);
         SCHEDULE_FRAME();
         consumed = true;
@@ -291,7 +300,9 @@ bool itn_scrollbar_handle_button_release(Canvas *canvas, XButtonEvent *event) {
                 canvas->scroll_y = min(canvas->max_scroll_y, canvas->scroll_y + SCROLL_STEP);
             }
         }
-        redraw_canvas(canvas);
+        render_scroll_canvas(canvas, old_scroll_x, old_scroll_y);
+        old_scroll_x = canvas->scroll_x;  // Pixels are current now
+        old_scroll_y = canvas->scroll_y;
         DAMAGE_CANVAS(canvas);
         SCHEDULE_FRAME();
         consumed = true;
@@ -307,7 +318,9 @@ bool itn_scrollbar_handle_button_release(Canvas *canvas, XButtonEvent *event) {
                 canvas->scroll_x = max(0, canvas->scroll_x - SCROLL_STEP);
             }
         }
-        redraw_canvas(canvas);
+        render_scroll_canvas(canvas, old_scroll_x, old_scroll_y);
+        old_scroll_x = canvas->scroll_x;  // Pixels are current now
+        old_scroll_y = canvas->scroll_y;
         DAMAGE_CANVAS(canvas);
         SCHEDULE_FRAME();
         consumed = true;
@@ -323,7 +336,9 @@ bool itn_scrollbar_handle_button_release(Canvas *canvas, XButtonEvent *event) {
                 canvas->scroll_x = min(canvas->max_scroll_x, canvas->scroll_x + SCROLL_STEP);
             }
         }
-        redraw_canvas(canvas);
+        render_scroll_canvas(canvas, old_scroll_x, old_scroll_y);
+        old_scroll_x = canvas->scroll_x;  // Pixels are current now
+        old_scroll_y = canvas->scroll_y;
         DAMAGE_CANVAS(canvas);
         SCHEDULE_FRAME();
         consumed = true;
@@ -443,7 +458,8 @@ bool itn_scrollbar_handle_motion_cancel(Canvas *canvas, XMotionEvent *event) {
     }
 
     if (needs_redraw) {
-        redraw_canvas(canvas);
+        // Arrow look only - content didn't move, so no icons are redrawn
+        render_scroll_canvas(canvas, canvas->scroll_x, canvas->scroll_y);
         DAMAGE_CANVAS(canvas);
         SCHEDULE_FRAME();
     }
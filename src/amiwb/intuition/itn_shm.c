@@ -0,0 +1,427 @@
+// File: itn_shm.c
+// CPU compositing backend - MIT-SHM fetch, in-process blend, XShmPutImage
+// Optional (amiwbrc composite_backend = 1). For servers where XRender
+// composites hit slow software paths anyway (Xvfb, VNC, some drivers):
+// window pixels come into our memory through a shared segment, get blended
+// into a shared back buffer (itn_blend.c kernels) and only the repaint
+// rects are put back. itn_composite.c still decides WHAT to draw (damage,
+// occlusion) - this module only replaces the XRender calls.
+
+#include "itn_internal.h"
+#include "../config.h"
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Module-Private State
+// ============================================================================
+
+typedef struct {
+    XShmSegmentInfo info;
+    XImage *image;          // Only the back buffer keeps an image
+    size_t size;
+} ShmBuffer;
+
+static bool g_shm_active = false;
+static Drawable g_target = None;     // Overlay window (or root)
+static GC g_target_gc = None;
+static int g_width = 0, g_height = 0;
+
+static ShmBuffer g_back = {0};       // Screen-sized ARGB32 back buffer
+static ShmBuffer g_fetch = {0};      // Scratch for XShmGetImage (screen-sized)
+static uint32_t *g_scale_row = NULL; // One scaled source row (screen width)
+
+static bool g_fetch_failed = false;  // Set by the error handler during a fetch
+static bool g_put_pending = false;   // Swap queued, server may still read g_back
+static Visual *g_argb_visual = NULL; // For fetching depth 32 drawables
+
+static struct {
+    uint64_t fetches;
+    uint64_t fetch_errors;
+    uint64_t pixels_fetched;
+    uint64_t puts;
+    uint64_t pixels_put;
+} g_shm_stats = {0};
+
+// ============================================================================
+// Internal Implementation
+// ============================================================================
+
+// Windows/pixmaps can vanish between damage and fetch (tooltips) - skip them
+static int shm_fetch_error_handler(Display *dpy, XErrorEvent *error) {
+    (void)dpy;
+    (void)error;
+    g_fetch_failed = true;
+    return 0;
+}
+
+static void free_segment(Display *dpy, ShmBuffer *buf) {
+    if (buf->image) {
+        XDestroyImage(buf->image);  // SHM image: frees the struct, not the segment
+        buf->image = NULL;
+    }
+    if (buf->info.shmaddr && buf->info.shmaddr != (char *)-1) {
+        XShmDetach(dpy, &buf->info);
+        shmdt(buf->info.shmaddr);
+    }
+    memset(&buf->info, 0, sizeof(buf->info));
+    buf->size = 0;
+}
+
+// Create a segment of size bytes and attach it on both sides
+static bool alloc_segment(Display *dpy, ShmBuffer *buf, size_t size) {
+    memset(&buf->info, 0, sizeof(buf->info));
+    buf->info.shmid = shmget(IPC_PRIVATE, size, IPC_CREAT | 0600);
+    if (buf->info.shmid < 0) {
+        log_error("[SHM] shmget(%zu) failed", size);
+        return false;
+    }
+    buf->info.shmaddr = shmat(buf->info.shmid, NULL, 0);
+    if (buf->info.shmaddr == (char *)-1) {
+        log_error("[SHM] shmat failed");
+        shmctl(buf->info.shmid, IPC_RMID, NULL);
+        buf->info.shmaddr = NULL;
+        return false;
+    }
+    buf->info.readOnly = False;
+    if (!XShmAttach(dpy, &buf->info)) {
+        log_error("[SHM] XShmAttach failed");
+        shmdt(buf->info.shmaddr);
+        shmctl(buf->info.shmid, IPC_RMID, NULL);
+        buf->info.shmaddr = NULL;
+        return false;
+    }
+    XSync(dpy, False);
+    // Marked for removal now - goes away with the last detach, even on crash
+    shmctl(buf->info.shmid, IPC_RMID, NULL);
+    buf->size = size;
+    return true;
+}
+
+static bool create_buffers(Display *dpy, int width, int height) {
+    size_t size = (size_t)width * height * 4;
+    Visual *visual = DefaultVisual(dpy, DefaultScreen(dpy));
+    int depth = DefaultDepth(dpy, DefaultScreen(dpy));
+
+    if (!alloc_segment(dpy, &g_back, size)) return false;
+    g_back.image = XShmCreateImage(dpy, visual, depth, ZPixmap,
+                                   g_back.info.shmaddr, &g_back.info, width, height);
+    if (!g_back.image || g_back.image->bits_per_pixel != 32 ||
+        g_back.image->bytes_per_line != width * 4) {
+        log_error("[SHM] Screen is not 32 bits per pixel - CPU backend unusable");
+        free_segment(dpy, &g_back);
+        return false;
+    }
+
+    if (!alloc_segment(dpy, &g_fetch, size)) {
+        free_segment(dpy, &g_back);
+        return false;
+    }
+
+    free(g_scale_row);
+    g_scale_row = malloc((size_t)width * 4);
+    if (!g_scale_row) {
+        free_segment(dpy, &g_back);
+        free_segment(dpy, &g_fetch);
+        return false;
+    }
+
+    g_width = width;
+    g_height = height;
+    return true;
+}
+
+static inline uint32_t *back_row(int y) {
+    return (uint32_t *)(g_back.info.shmaddr + (size_t)y * g_width * 4);
+}
+
+// Visual matching a drawable depth - ARGB for 32, the screen's otherwise
+static Visual *visual_for_depth(Display *dpy, int depth) {
+    if (depth == 32) {
+        if (!g_argb_visual) {
+            XVisualInfo vinfo;
+            if (XMatchVisualInfo(dpy, DefaultScreen(dpy), 32, TrueColor, &vinfo)) {
+                g_argb_visual = vinfo.visual;
+            }
+        }
+        if (g_argb_visual) return g_argb_visual;
+    }
+    return DefaultVisual(dpy, DefaultScreen(dpy));
+}
+
+// Bounding box of rects (false if they cover nothing)
+static bool rects_bounds(const XRectangle *rects, int count, int *bx, int *by, int *bw, int *bh) {
+    int x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+    bool any = false;
+    for (int r = 0; r < count; r++) {
+        if (rects[r].width == 0 || rects[r].height == 0) continue;
+        int rx2 = rects[r].x + rects[r].width, ry2 = rects[r].y + rects[r].height;
+        if (!any) {
+            x1 = rects[r].x; y1 = rects[r].y; x2 = rx2; y2 = ry2;
+            any = true;
+        } else {
+            x1 = min(x1, (int)rects[r].x); y1 = min(y1, (int)rects[r].y);
+            x2 = max(x2, rx2); y2 = max(y2, ry2);
+        }
+    }
+    *bx = x1; *by = y1; *bw = x2 - x1; *bh = y2 - y1;
+    return any;
+}
+
+// The previous swap's XShmPutImage must be done before g_back is written.
+// Any fetch is a round trip that follows it, so this only syncs when a
+// frame writes before fetching anything (plain black background)
+static void back_buffer_ready(Display *dpy) {
+    if (!g_put_pending) return;
+    XSync(dpy, False);
+    g_put_pending = false;
+}
+
+// Fetch one rect of a drawable into the scratch segment (w*h packed pixels)
+// Returns false if the drawable is gone or the read failed
+static bool fetch_rect(Display *dpy, Drawable src, int depth, int sx, int sy, int w, int h) {
+    Visual *visual = visual_for_depth(dpy, depth);
+    XImage *img = XShmCreateImage(dpy, visual, depth, ZPixmap,
+                                  g_fetch.info.shmaddr, &g_fetch.info, w, h);
+    if (!img) return false;
+    if (img->bits_per_pixel != 32 || img->bytes_per_line != w * 4) {
+        XDestroyImage(img);
+        return false;
+    }
+
+    g_fetch_failed = false;
+    XErrorHandler old_handler = XSetErrorHandler(shm_fetch_error_handler);
+    Status ok = XShmGetImage(dpy, src, img, sx, sy, AllPlanes);
+    XSetErrorHandler(old_handler);
+    XDestroyImage(img);
+    g_put_pending = false;  // Reply came back - earlier requests are done
+
+    g_shm_stats.fetches++;
+    if (!ok || g_fetch_failed) {
+        g_shm_stats.fetch_errors++;
+        return false;
+    }
+    g_shm_stats.pixels_fetched += (uint64_t)w * h;
+    return true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+// Enable CPU compositing onto target (the compositor overlay)
+// Returns false if MIT-SHM is missing or the visual isn't 32bpp - caller
+// keeps the XRender path
+bool itn_shm_init(Window target, int width, int height) {
+    Display *dpy = itn_core_get_display();
+    if (!dpy || target == None || width <= 0 || height <= 0) return false;
+
+    int major, minor;
+    Bool pixmaps;
+    if (!XShmQueryExtension(dpy) || !XShmQueryVersion(dpy, &major, &minor, &pixmaps)) {
+        log_error("[SHM] MIT-SHM not available - using XRender compositing");
+        return false;
+    }
+
+    if (!create_buffers(dpy, width, height)) {
+        log_error("[SHM] Buffer setup failed - using XRender compositing");
+        return false;
+    }
+
+    g_target = target;
+    g_target_gc = XCreateGC(dpy, target, 0, NULL);
+    itn_blend_init();
+    g_shm_active = true;
+
+    log_error("[SHM] CPU compositing backend enabled (MIT-SHM %d.%d, %s blend, %dx%d)",
+              major, minor, itn_blend_kernel_name(), width, height);
+    return true;
+}
+
+void itn_shm_cleanup(void) {
+    Display *dpy = itn_core_get_display();
+    if (dpy) {
+        free_segment(dpy, &g_back);
+        free_segment(dpy, &g_fetch);
+        if (g_target_gc) XFreeGC(dpy, g_target_gc);
+    }
+    free(g_scale_row);
+    g_scale_row = NULL;
+    g_target_gc = None;
+    g_target = None;
+    g_shm_active = false;
+}
+
+bool itn_shm_is_active(void) {
+    return g_shm_active;
+}
+
+// Screen size changed (XRandR) - reallocate both segments
+bool itn_shm_resize(int width, int height) {
+    Display *dpy = itn_core_get_display();
+    if (!g_shm_active || !dpy) return false;
+    if (width == g_width && height == g_height) return true;
+
+    free_segment(dpy, &g_back);
+    free_segment(dpy, &g_fetch);
+    if (!create_buffers(dpy, width, height)) {
+        log_error("[SHM] Resize to %dx%d failed - CPU backend disabled", width, height);
+        if (g_target_gc) XFreeGC(dpy, g_target_gc);
+        g_target_gc = None;
+        g_shm_active = false;
+        return false;
+    }
+    return true;
+}
+
+// Background for the uncovered rects: wallpaper where it reaches, black elsewhere
+void itn_shm_draw_background(const XRectangle *rects, int count,
+                             Pixmap wallpaper, int wall_w, int wall_h) {
+    Display *dpy = itn_core_get_display();
+    if (!g_shm_active || !dpy) return;
+
+    // One fetch for the wallpaper under all rects (bounding box)
+    int bx, by, bw, bh;
+    bool have_wall = wallpaper && rects_bounds(rects, count, &bx, &by, &bw, &bh);
+    if (have_wall) {
+        bw = min(bx + bw, wall_w) - bx;
+        bh = min(by + bh, wall_h) - by;
+        have_wall = bw > 0 && bh > 0 &&
+                    fetch_rect(dpy, wallpaper, DefaultDepth(dpy, DefaultScreen(dpy)),
+                               bx, by, bw, bh);
+    }
+    back_buffer_ready(dpy);
+    const uint32_t *wall = (const uint32_t *)g_fetch.info.shmaddr;
+
+    for (int r = 0; r < count; r++) {
+        int x = rects[r].x, y = rects[r].y;
+        int w = rects[r].width, h = rects[r].height;
+
+        for (int row = 0; row < h; row++) {
+            uint32_t *dst = back_row(y + row) + x;
+            for (int i = 0; i < w; i++) dst[i] = 0xff000000u;
+        }
+
+        // Wallpaper part of this rect
+        int ww = min(x + w, bx + bw) - x;
+        int wh = min(y + h, by + bh) - y;
+        if (!have_wall || ww <= 0 || wh <= 0) continue;
+        for (int row = 0; row < wh; row++) {
+            const uint32_t *src = wall + (size_t)(y + row - by) * bw + (x - bx);
+            itn_blend_copy_row(back_row(y + row) + x, src, ww);
+        }
+    }
+}
+
+// Composite rects (screen coordinates) of a drawable whose origin is at
+// (origin_x, origin_y) on screen. depth 32 blends premultiplied OVER,
+// anything else is opaque and copied. One fetch (one round trip) over the
+// bounding box of the rects - they all lie inside the drawable.
+void itn_shm_composite(Drawable src, int depth, int origin_x, int origin_y,
+                       const XRectangle *rects, int count) {
+    Display *dpy = itn_core_get_display();
+    if (!g_shm_active || !dpy || !src) return;
+
+    int bx, by, bw, bh;
+    if (!rects_bounds(rects, count, &bx, &by, &bw, &bh)) return;
+    if (!fetch_rect(dpy, src, depth, bx - origin_x, by - origin_y, bw, bh)) {
+        return;  // Drawable gone
+    }
+    const uint32_t *pixels = (const uint32_t *)g_fetch.info.shmaddr;
+
+    for (int r = 0; r < count; r++) {
+        int x = rects[r].x, y = rects[r].y;
+        int w = rects[r].width, h = rects[r].height;
+        if (w <= 0 || h <= 0) continue;
+
+        for (int row = 0; row < h; row++) {
+            const uint32_t *line = pixels + (size_t)(y + row - by) * bw + (x - bx);
+            if (depth == 32) {
+                itn_blend_over_row(back_row(y + row) + x, line, w);
+            } else {
+                itn_blend_copy_row(back_row(y + row) + x, line, w);
+            }
+        }
+    }
+}
+
+// Interactive resize: the client still shows src_w x src_h at the top left
+// of its content area (window coordinates) - stretch that over the whole
+// area, nearest neighbour, limited to rects (screen coordinates). Same
+// result as the XRender path's scaled composite, minus the bilinear filter.
+void itn_shm_composite_stretched(Drawable src, int depth, int origin_x, int origin_y,
+                                 const XRectangle *content, int src_w, int src_h,
+                                 const XRectangle *rects, int count) {
+    Display *dpy = itn_core_get_display();
+    if (!g_shm_active || !dpy || !src || !content) return;
+    int cw = content->width, ch = content->height;
+    int sw = min(src_w, cw), sh = min(src_h, ch);
+    if (sw <= 0 || sh <= 0) return;
+
+    // Whole source once - every destination row samples from it
+    if (!fetch_rect(dpy, src, depth, content->x, content->y, sw, sh)) return;
+    const uint32_t *pixels = (const uint32_t *)g_fetch.info.shmaddr;
+
+    int area_x = origin_x + content->x, area_y = origin_y + content->y;
+    uint32_t du = (uint32_t)(((uint64_t)sw << 16) / cw);
+    uint32_t dv = (uint32_t)(((uint64_t)sh << 16) / ch);
+
+    for (int r = 0; r < count; r++) {
+        // Part of this rect inside the content area
+        int x1 = max(area_x, rects[r].x), y1 = max(area_y, rects[r].y);
+        int x2 = min(area_x + cw, rects[r].x + rects[r].width);
+        int y2 = min(area_y + ch, rects[r].y + rects[r].height);
+        if (x2 <= x1 || y2 <= y1) continue;
+
+        int w = x2 - x1;
+        uint32_t u_first = (uint32_t)(x1 - area_x) * du;
+        for (int y = y1; y < y2; y++) {
+            uint64_t v = (uint64_t)(y - area_y) * dv;
+            const uint32_t *line = pixels + (size_t)(v >> 16) * sw;
+            itn_blend_scale_row(g_scale_row, line, u_first, du, w);
+            if (depth == 32) {
+                itn_blend_over_row(back_row(y) + x1, g_scale_row, w);
+            } else {
+                itn_blend_copy_row(back_row(y) + x1, g_scale_row, w);
+            }
+        }
+    }
+}
+
+// Put the repaint rects of the back buffer on screen
+// No XSync here: the next frame's first fetch is a round trip behind these
+// puts, and back_buffer_ready() syncs if a frame writes before fetching
+void itn_shm_swap(const XRectangle *rects, int count) {
+    Display *dpy = itn_core_get_display();
+    if (!g_shm_active || !dpy) return;
+
+    for (int r = 0; r < count; r++) {
+        XShmPutImage(dpy, g_target, g_target_gc, g_back.image,
+                     rects[r].x, rects[r].y, rects[r].x, rects[r].y,
+                     rects[r].width, rects[r].height, False);
+        g_shm_stats.puts++;
+        g_shm_stats.pixels_put += (uint64_t)rects[r].width * rects[r].height;
+    }
+    XFlush(dpy);
+    g_put_pending = (count > 0);
+}
+
+// Append CPU backend statistics to the [METRICS] log and reset them
+void itn_shm_log_metrics(void) {
+    if (!g_shm_active) return;
+
+    log_error("[METRICS] CPU Compositing (MIT-SHM, %s):", itn_blend_kernel_name());
+    log_error("[METRICS]   Fetches: %lu (%lu failed), %.1f megapixels",
+              g_shm_stats.fetches, g_shm_stats.fetch_errors,
+              g_shm_stats.pixels_fetched / 1000000.0);
+    log_error("[METRICS]   Puts: %lu, %.1f megapixels",
+              g_shm_stats.puts, g_shm_stats.pixels_put / 1000000.0);
+
+    memset(&g_shm_stats, 0, sizeof(g_shm_stats));
+}
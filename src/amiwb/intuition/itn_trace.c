@@ -0,0 +1,277 @@
+// File: itn_trace.c
+// Frame timing - percentile histograms and a ring of recent frames
+// process_frame brackets each frame, the compositor marks phase boundaries.
+// Histograms cover the whole session (not reset by the [METRICS] dump) so a
+// regression after an upgrade shows up in p99 instead of disappearing into
+// an average. The frame ring can be written as Chrome trace-event JSON
+// (chrome://tracing, Perfetto) for a frame-by-frame look.
+
+#include "itn_internal.h"
+#include "../config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+// Histogram layout (HDR-style, values in microseconds):
+// below 32us one bucket per microsecond, above that 16 buckets per power of
+// two (~6% precision), up to 2^25us (33s) - anything longer lands in the last
+#define HIST_LINEAR      32
+#define HIST_SUB_BITS    4
+#define HIST_SUB         (1 << HIST_SUB_BITS)
+#define HIST_MAX_MSB     24
+#define HIST_BUCKETS     (HIST_LINEAR + (HIST_MAX_MSB - 4) * HIST_SUB)
+
+#define TRACE_RING_SIZE  600     // ~10 seconds at 60Hz
+#define TRACE_FILE_NAME  "frametrace.json"
+
+// ============================================================================
+// Module-Private State
+// ============================================================================
+
+typedef struct {
+    uint32_t buckets[HIST_BUCKETS];
+    uint64_t count;
+    uint64_t max_us;
+} Histogram;
+
+typedef struct {
+    uint64_t start_ns;
+    uint64_t total_ns;
+    uint64_t input_ns;                   // Oldest input served by this frame (0 = none)
+    uint64_t phase_ns[ITN_PHASE_COUNT];
+} FrameRecord;
+
+static const char *phase_names[ITN_PHASE_COUNT] = {
+    "stack", "rename", "composite", "overrides", "swap"
+};
+
+static Histogram g_frame_hist;
+static Histogram g_input_hist;
+static Histogram g_phase_hist[ITN_PHASE_COUNT];
+
+static FrameRecord g_ring[TRACE_RING_SIZE];
+static int g_ring_head = 0;      // Next slot to write
+static int g_ring_count = 0;
+
+// Current frame
+static bool g_in_frame = false;
+static uint64_t g_frame_start_ns = 0;
+static uint64_t g_last_mark_ns = 0;
+static uint64_t g_phase_ns[ITN_PHASE_COUNT];
+
+// First input event not yet followed by a frame
+static uint64_t g_input_pending_ns = 0;
+
+// Input event being handled - only counts if its handler damages something
+static uint64_t g_input_candidate_ns = 0;
+static uint64_t g_input_candidate_serial = 0;
+
+// ============================================================================
+// Internal Implementation
+// ============================================================================
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int bucket_for(uint64_t us) {
+    if (us < HIST_LINEAR) return (int)us;
+
+    int msb = 63 - __builtin_clzll(us);          // >= 5
+    if (msb > HIST_MAX_MSB) return HIST_BUCKETS - 1;
+    int sub = (int)((us >> (msb - HIST_SUB_BITS)) & (HIST_SUB - 1));
+    return HIST_LINEAR + (msb - 5) * HIST_SUB + sub;
+}
+
+// Upper bound of a bucket - percentiles report the conservative value
+static uint64_t bucket_limit(int index) {
+    if (index < HIST_LINEAR) return (uint64_t)index;
+
+    int msb = (index - HIST_LINEAR) / HIST_SUB + 5;
+    int sub = (index - HIST_LINEAR) % HIST_SUB;
+    uint64_t step = 1ULL << (msb - HIST_SUB_BITS);
+    return (uint64_t)(HIST_SUB + sub) * step + step - 1;
+}
+
+static void hist_record(Histogram *h, uint64_t ns) {
+    uint64_t us = ns / 1000;
+    h->buckets[bucket_for(us)]++;
+    h->count++;
+    if (us > h->max_us) h->max_us = us;
+}
+
+static double hist_percentile_ms(const Histogram *h, double pct) {
+    if (h->count == 0) return 0.0;
+
+    uint64_t rank = (uint64_t)((pct / 100.0) * (double)h->count + 0.5);
+    if (rank < 1) rank = 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        seen += h->buckets[i];
+        if (seen >= rank) {
+            uint64_t limit = bucket_limit(i);
+            if (limit > h->max_us) limit = h->max_us;
+            return limit / 1000.0;
+        }
+    }
+    return h->max_us / 1000.0;
+}
+
+static void log_hist(const char *label, const Histogram *h) {
+    if (h->count == 0) return;
+    log_error("[METRICS]   %-10s p50 %6.2f  p95 %6.2f  p99 %6.2f  p99.9 %6.2f  max %6.2f ms (n=%lu)",
+              label,
+              hist_percentile_ms(h, 50.0), hist_percentile_ms(h, 95.0),
+              hist_percentile_ms(h, 99.0), hist_percentile_ms(h, 99.9),
+              h->max_us / 1000.0, h->count);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+// Start timing a frame (itn_render_process_frame)
+void itn_trace_frame_begin(void) {
+    g_frame_start_ns = now_ns();
+    g_last_mark_ns = g_frame_start_ns;
+    memset(g_phase_ns, 0, sizeof(g_phase_ns));
+    g_in_frame = true;
+}
+
+// Charge the time since the previous mark to a phase
+// Phases may interleave (re-naming happens inside the occlusion pass) - every
+// interval goes to exactly one phase, so the phases add up to the frame time
+void itn_trace_mark(ItnPhase phase) {
+    if (!g_in_frame || phase < 0 || phase >= ITN_PHASE_COUNT) return;
+    uint64_t t = now_ns();
+    g_phase_ns[phase] += t - g_last_mark_ns;
+    g_last_mark_ns = t;
+}
+
+// Finish the frame: feed histograms and the ring
+void itn_trace_frame_end(void) {
+    if (!g_in_frame) return;
+    g_in_frame = false;
+
+    uint64_t end = now_ns();
+    FrameRecord *rec = &g_ring[g_ring_head];
+    rec->start_ns = g_frame_start_ns;
+    rec->total_ns = end - g_frame_start_ns;
+    rec->input_ns = 0;
+    memcpy(rec->phase_ns, g_phase_ns, sizeof(g_phase_ns));
+
+    hist_record(&g_frame_hist, rec->total_ns);
+
+    // Phases that didn't run this frame (legacy path, bypass) are not samples
+    for (int p = 0; p < ITN_PHASE_COUNT; p++) {
+        if (g_phase_ns[p] > 0) hist_record(&g_phase_hist[p], g_phase_ns[p]);
+    }
+
+    // Input-to-frame: from the oldest unserved input to the end of this frame
+    if (g_input_pending_ns && g_input_pending_ns <= g_frame_start_ns) {
+        rec->input_ns = g_input_pending_ns;
+        hist_record(&g_input_hist, end - g_input_pending_ns);
+        g_input_pending_ns = 0;
+    }
+
+    g_ring_head = (g_ring_head + 1) % TRACE_RING_SIZE;
+    if (g_ring_count < TRACE_RING_SIZE) g_ring_count++;
+}
+
+// Input event (button, key, motion) about to be handled
+// Only a candidate: a pointer move over the desktop draws nothing, and
+// timing it would charge the gap to some later unrelated frame
+void itn_trace_input_begin(void) {
+    g_input_candidate_ns = now_ns();
+    g_input_candidate_serial = itn_render_damage_serial();
+}
+
+// Handler done - start the input-to-frame clock if it damaged anything
+// Only the first such input until the next frame counts, later ones wait less
+void itn_trace_input_end(void) {
+    if (g_input_candidate_ns == 0) return;
+    if (g_input_pending_ns == 0 && itn_render_damage_serial() != g_input_candidate_serial) {
+        g_input_pending_ns = g_input_candidate_ns;
+    }
+    g_input_candidate_ns = 0;
+}
+
+// Append percentile tables to the [METRICS] log (session totals, not reset)
+void itn_trace_log_metrics(void) {
+    if (g_frame_hist.count == 0) return;
+
+    log_error("[METRICS] Frame Time Percentiles (session):");
+    log_hist("frame", &g_frame_hist);
+    log_hist("input", &g_input_hist);
+    for (int p = 0; p < ITN_PHASE_COUNT; p++) {
+        log_hist(phase_names[p], &g_phase_hist[p]);
+    }
+}
+
+// Write the frame ring as Chrome trace-event JSON
+// path NULL = ~/.config/amiwb/frametrace.json. Phases are laid end to end
+// inside their frame (their real order interleaves). Returns false on error.
+bool itn_trace_dump(const char *path) {
+    char default_path[PATH_SIZE];
+    if (!path) {
+        const char *home = getenv("HOME");
+        if (!home) {
+            log_error("[TRACE] HOME not set - cannot write frame trace");
+            return false;
+        }
+        snprintf(default_path, sizeof(default_path), "%s/%s/%s",
+                 home, RESOURCE_DIR_USER, TRACE_FILE_NAME);
+        path = default_path;
+    }
+
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        log_error("[TRACE] Cannot write frame trace to %s", path);
+        return false;
+    }
+
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"frames\"}},\n");
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"input latency\"}}");
+
+    int first = (g_ring_head - g_ring_count + TRACE_RING_SIZE) % TRACE_RING_SIZE;
+    for (int n = 0; n < g_ring_count; n++) {
+        const FrameRecord *rec = &g_ring[(first + n) % TRACE_RING_SIZE];
+        double ts = rec->start_ns / 1000.0;
+
+        fprintf(f, ",\n{\"name\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                ts, rec->total_ns / 1000.0);
+
+        double phase_ts = ts;
+        for (int p = 0; p < ITN_PHASE_COUNT; p++) {
+            if (rec->phase_ns[p] == 0) continue;
+            fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                    phase_names[p], phase_ts, rec->phase_ns[p] / 1000.0);
+            phase_ts += rec->phase_ns[p] / 1000.0;
+        }
+
+        if (rec->input_ns) {
+            uint64_t end_ns = rec->start_ns + rec->total_ns;
+            fprintf(f, ",\n{\"name\":\"input->frame\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":%.3f,\"dur\":%.3f}",
+                    rec->input_ns / 1000.0, (end_ns - rec->input_ns) / 1000.0);
+        }
+    }
+
+    fprintf(f, "\n]}\n");
+    bool ok = (fclose(f) == 0);
+    if (ok) {
+        log_error("[TRACE] Wrote %d frames to %s", g_ring_count, path);
+    } else {
+        log_error("[TRACE] Failed writing frame trace to %s", path);
+    }
+    return ok;
+}
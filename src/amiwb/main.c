@@ -47,8 +47,9 @@ void log_error(const char *format, ...) {
     // Add timestamp
     time_t now;
     time(&now);
-    struct tm *tm_info = localtime(&now);
-    fprintf(log, "[%02d:%02d:%02d] ", tm_info->tm_hour, tm_info->tm_min, tm_info->tm_sec);
+    struct tm tm_info;  // localtime_r - icon decoder threads log too
+    localtime_r(&now, &tm_info);
+    fprintf(log, "[%02d:%02d:%02d] ", tm_info.tm_hour, tm_info.tm_min, tm_info.tm_sec);
     
     va_list args;
     va_start(args, format);
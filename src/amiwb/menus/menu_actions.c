@@ -101,21 +101,13 @@ static void rename_file_ok_callback(const char *new_name) {
         }
         
         // Recalculate label width after rename
-        XftFont *font = get_font();
-        if (icon->label && font) {
-            RenderContext *ctx = get_render_context();
-            if (ctx) {
-                XGlyphInfo extents;
-                XftTextExtentsUtf8(ctx->dpy, font, (FcChar8 *)icon->label, strlen(icon->label), &extents);
-                icon->label_width = extents.xOff;
-            }
-        }
+        icon_update_label_width(icon);
         
         // Refresh display WITHOUT full directory reload - just update this icon
         Canvas *canvas = itn_canvas_find_by_window(icon->display_window);
         if (canvas && canvas->path) {
-            // Just redraw the canvas with the updated icon label
-            redraw_canvas(canvas);
+            // Only the renamed icon changed - retained redraw picks it up
+            redraw_canvas_icons(canvas, false);
 
             // Let compositor handle updates through events
             XSync(itn_core_get_display(), False);
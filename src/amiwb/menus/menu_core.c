@@ -162,8 +162,7 @@ int get_submenu_width(Menu *menu) {
     for (int i = 0; i < menu->item_count; i++) {
         // Measure label width
         XGlyphInfo label_extents;
-        XftTextExtentsUtf8(get_render_context()->dpy, font_manager_get(),
-            (FcChar8 *)menu->items[i], strlen(menu->items[i]), &label_extents);
+        font_manager_text_extents(font_manager_get(), menu->items[i], &label_extents);
         if (label_extents.xOff > max_label_width) {
             max_label_width = label_extents.xOff;
         }
@@ -178,8 +177,7 @@ int get_submenu_width(Menu *menu) {
                 snprintf(shortcut_text, sizeof(shortcut_text), "%s %s", SHORTCUT_SYMBOL, menu->shortcuts[i]);
             }
             XGlyphInfo shortcut_extents;
-            XftTextExtentsUtf8(get_render_context()->dpy, font_manager_get(),
-                (FcChar8 *)shortcut_text, strlen(shortcut_text), &shortcut_extents);
+            font_manager_text_extents(font_manager_get(), shortcut_text, &shortcut_extents);
             if (shortcut_extents.xOff > max_shortcut_width) {
                 max_shortcut_width = shortcut_extents.xOff;
             }
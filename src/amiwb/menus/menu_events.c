@@ -27,8 +27,7 @@ void menu_handle_menubar_motion(XMotionEvent *event) {
     int padding = 20;
     for (int i = 0; i < menubar->item_count; i++) {
         XGlyphInfo extents;
-        XftTextExtentsUtf8(ctx->dpy, font_manager_get(), (FcChar8 *)menubar->items[i],
-            strlen(menubar->items[i]), &extents);
+        font_manager_text_extents(font_manager_get(), menubar->items[i], &extents);
         int item_width = extents.xOff + padding;
         if (event->x >= x_pos && event->x < x_pos + item_width) {
             menubar->selected_item = i;
@@ -65,8 +64,7 @@ void menu_handle_menubar_motion(XMotionEvent *event) {
             int submenu_x = 10;
             for (int j = 0; j < menubar->selected_item; j++) {
                 XGlyphInfo extents;
-                XftTextExtentsUtf8(ctx->dpy, font_manager_get(), (FcChar8 *)menubar->items[j],
-                    strlen(menubar->items[j]), &extents);
+                font_manager_text_extents(font_manager_get(), menubar->items[j], &extents);
                 submenu_x += extents.xOff + padding;
             }
             show_dropdown_menu(menubar, menubar->selected_item, submenu_x,
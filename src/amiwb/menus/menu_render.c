@@ -20,25 +20,20 @@ int menu_render_text(RenderContext *ctx, Canvas *menubar, const char *text, int
     XftFont *font = font_manager_get();
     if (!font || !menubar->xft_draw) return 0;
 
-    // Allocate text color
-    XftColor text_color;
-    XRenderColor black = BLACK;
-    XftColorAllocValue(ctx->dpy, menubar->visual, menubar->colormap, &black, &text_color);
+    // Text color from the render palette (allocated once per colormap)
+    XftColor *text_color = render_xft_color(menubar->visual, menubar->colormap, &BLACK);
 
     // Measure text width
     XGlyphInfo extents;
-    XftTextExtentsUtf8(ctx->dpy, font, (FcChar8 *)text, strlen(text), &extents);
+    font_manager_text_extents(font, text, &extents);
 
     // Calculate y position centered in menubar
     int text_y = font->ascent + (MENU_ITEM_HEIGHT - font->height) / 2 - 1;  // Raised by 1 pixel
 
     // Render text
-    XftDrawStringUtf8(menubar->xft_draw, &text_color, font, x, text_y,
+    XftDrawStringUtf8(menubar->xft_draw, text_color, font, x, text_y,
                       (FcChar8 *)text, strlen(text));
 
-    // Free color
-    XftColorFree(ctx->dpy, menubar->visual, menubar->colormap, &text_color);
-
     return extents.xOff;
 }
 
@@ -51,7 +46,7 @@ int menu_measure_text(RenderContext *ctx, const char *text) {
     if (!font) return 0;
 
     XGlyphInfo extents;
-    XftTextExtentsUtf8(ctx->dpy, font, (FcChar8 *)text, strlen(text), &extents);
+    font_manager_text_extents(font, text, &extents);
 
     return extents.xOff;
 }
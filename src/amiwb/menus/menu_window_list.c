@@ -121,7 +121,7 @@ void show_window_list_menu(int x, int y) {
     XGlyphInfo extents;
     // Measure 20 chars worth of typical text (use "M" as average width char)
     char sample_text[21] = "MMMMMMMMMMMMMMMMMMMM";  // 20 Ms for width calculation
-    XftTextExtentsUtf8(ctx->dpy, font_manager_get(), (FcChar8 *)sample_text, 20, &extents);
+    font_manager_text_extents(font_manager_get(), sample_text, &extents);
 
     // Add padding: 10px left, 10px right
     int menu_width = extents.xOff + 20;
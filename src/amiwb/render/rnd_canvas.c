@@ -73,15 +73,41 @@ static void composite_to_window(Canvas *canvas, RenderContext *ctx) {
                     copy_width, copy_height);
 }
 
+// Selection rectangle (rubber band) of the last draw - it lives on the
+// window only, never in canvas_buffer, so moving it just restores the old
+// area from the buffer instead of re-rendering the icons under it
+static Canvas *g_overlay_canvas = NULL;
+static XRectangle g_overlay_rect = {0, 0, 0, 0};
+
+// Draw the selection rectangle on the window after a buffer copy
+// restore: the window still shows the previous rectangle (partial copies)
+static void update_selection_overlay(Canvas *canvas, RenderContext *ctx, bool restore) {
+    if (restore && g_overlay_canvas == canvas && g_overlay_rect.width > 0) {
+        XRenderComposite(ctx->dpy, PictOpSrc, canvas->canvas_render, None,
+                         canvas->window_render, g_overlay_rect.x, g_overlay_rect.y, 0, 0,
+                         g_overlay_rect.x, g_overlay_rect.y,
+                         g_overlay_rect.width, g_overlay_rect.height);
+    }
+    if (g_overlay_canvas == canvas) {
+        g_overlay_canvas = NULL;
+        g_overlay_rect = (XRectangle){0, 0, 0, 0};
+    }
+
+    XRectangle rect;
+    if (wb_get_multiselection_rect(canvas, &rect)) {
+        wb_draw_multiselection_rect(canvas, canvas->win, canvas->visual);
+        g_overlay_canvas = canvas;
+        g_overlay_rect = rect;
+    }
+}
+
 // Render a single icon row in list view
 static void render_list_view_row(Canvas *canvas, RenderContext *ctx, Picture dest,
                                  FileIcon *icon, XftFont *font, int render_y, int row_h,
                                  int max_row_w, XftColor *white_col, XftColor *normal_col) {
-    // Compute text width
+    // Text width (cached on the icon)
     const char *label = icon->label ? icon->label : "";
-    XGlyphInfo ext;
-    XftTextExtentsUtf8(ctx->dpy, font, (FcChar8 *)label, strlen(label), &ext);
-    int sel_w = min(ext.xOff + 10, max_row_w);
+    int sel_w = min(icon_label_width(icon) + 10, max_row_w);
 
     // Background fill
     XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &canvas->bg_color,
@@ -105,19 +131,30 @@ static void render_list_view_row(Canvas *canvas, RenderContext *ctx, Picture des
     int text_x = BORDER_WIDTH_LEFT + 6 - canvas->scroll_x;
     XftDrawStringUtf8(canvas->xft_draw, color, font, text_x, baseline,
                      (FcChar8*)label, strlen(label));
+
+    // Rows always span the viewport - only the vertical extent is kept
+    IconDrawnState *d = &icon->drawn;
+    d->picture = icon->current_picture;
+    d->selected = icon->selected;
+    d->x = icon->x;
+    d->y = icon->y;
+    d->label_hash = render_label_hash(icon->label);
+    d->rect_x = 0;
+    d->rect_y = icon->y;
+    d->rect_w = 0;
+    d->rect_h = row_h;
 }
 
 // Render icons in list view (VIEW_NAMES)
 static void render_icons_list_view(Canvas *canvas, RenderContext *ctx,
                                    Picture dest, FileIcon **icon_array,
-                                   int icon_count, int view_bottom) {
+                                   int icon_count, int view_top, int view_bottom) {
     XftFont *font = get_font();
     if (!font || !canvas->xft_draw) return;
 
-    // Cache XftColors outside the loop (performance optimization)
-    XftColor white_col, normal_col;
-    XftColorAllocValue(ctx->dpy, canvas->visual, canvas->colormap, &WHITE, &white_col);
-    XftColorAllocValue(ctx->dpy, canvas->visual, canvas->colormap, &WINFONTCOL, &normal_col);
+    // Palette colors - allocated once per colormap, not per frame
+    XftColor *white_col = render_xft_color(canvas->visual, canvas->colormap, &WHITE);
+    XftColor *normal_col = render_xft_color(canvas->visual, canvas->colormap, &WINFONTCOL);
 
     int row_h = font->ascent + font->descent + 6;
     int max_row_w = canvas->width - BORDER_WIDTH_LEFT -
@@ -133,15 +170,11 @@ static void render_icons_list_view(Canvas *canvas, RenderContext *ctx,
         // Viewport clipping
         if (render_y > BORDER_HEIGHT_TOP + (view_bottom - canvas->scroll_y))
             continue;
-        if (render_y + row_h < BORDER_HEIGHT_TOP) continue;
+        if (render_y + row_h < BORDER_HEIGHT_TOP + (view_top - canvas->scroll_y)) continue;
 
         render_list_view_row(canvas, ctx, dest, icon, font, render_y, row_h, max_row_w,
-                            &white_col, &normal_col);
+                            white_col, normal_col);
     }
-
-    // Free cached colors once after loop
-    XftColorFree(ctx->dpy, canvas->visual, canvas->colormap, &white_col);
-    XftColorFree(ctx->dpy, canvas->visual, canvas->colormap, &normal_col);
 }
 
 // Render icons in grid view (VIEW_ICONS)
@@ -155,15 +188,8 @@ static void render_icons_grid_view(Canvas *canvas, FileIcon **icon_array,
         FileIcon *icon = icon_array[i];
         if (icon->display_window != canvas->win) continue;
 
-        // Calculate label width
-        int label_width = 0;
-        if (icon->label && font) {
-            XGlyphInfo extents;
-            XftTextExtentsUtf8(get_render_context()->dpy, font,
-                              (FcChar8 *)icon->label, strlen(icon->label),
-                              &extents);
-            label_width = extents.xOff;
-        }
+        // Label width (cached on the icon)
+        int label_width = (icon->label && font) ? icon_label_width(icon) : 0;
 
         // Icon bounding box includes centered label (labels centered below icons, can extend both sides)
         int icon_center = icon->x + icon->width / 2;
@@ -229,7 +255,7 @@ static void render_menu_content(Canvas *canvas, RenderContext *ctx) {
         bool has_checkmark = (menu->checkmarks && menu->checkmarks[i]);
 
         XGlyphInfo extents;
-        XftTextExtentsUtf8(ctx->dpy, font, (FcChar8 *)label, strlen(label), &extents);
+        font_manager_text_extents(font, label, &extents);
         int item_width = extents.xOff + padding;
 
         XRenderColor bg_color;
@@ -240,10 +266,8 @@ static void render_menu_content(Canvas *canvas, RenderContext *ctx) {
             fg_color = (i == selected && menu->submenus) ? WHITE : BLACK;
             XRenderFillRectangle(ctx->dpy, PictOpSrc, canvas->canvas_render, &bg_color, x, 0, item_width, MENU_ITEM_HEIGHT);
             XRenderFillRectangle(ctx->dpy, PictOpSrc, canvas->canvas_render, &BLACK, 0, MENU_ITEM_HEIGHT - 1, canvas->width, 1);
-            XftColor item_fg;
-            XftColorAllocValue(ctx->dpy, canvas->visual, canvas->colormap, &fg_color, &item_fg);
-            XftDrawStringUtf8(canvas->xft_draw, &item_fg, font, x + 10, y_base, (FcChar8 *)label, strlen(label));
-            XftColorFree(ctx->dpy, canvas->visual, canvas->colormap, &item_fg);
+            XftColor *item_fg = render_xft_color(canvas->visual, canvas->colormap, &fg_color);
+            XftDrawStringUtf8(canvas->xft_draw, item_fg, font, x + 10, y_base, (FcChar8 *)label, strlen(label));
             x += item_width;
         } else {
             // Vertical (submenu): highlight if selected, regardless of submenus
@@ -265,8 +289,7 @@ static void render_menu_content(Canvas *canvas, RenderContext *ctx) {
                 XRenderFillRectangle(ctx->dpy, PictOpSrc, canvas->canvas_render, &BLACK, 4, item_y + 1, canvas->width - 8, MENU_ITEM_HEIGHT - 2);
             }
             
-            XftColor item_fg;
-            XftColorAllocValue(ctx->dpy, canvas->visual, canvas->colormap, &fg_color, &item_fg);
+            XftColor *item_fg = render_xft_color(canvas->visual, canvas->colormap, &fg_color);
             
             // Check if we need to add " [WB]" suffix for window list menu
             char display_label[256];
@@ -305,20 +328,20 @@ static void render_menu_content(Canvas *canvas, RenderContext *ctx) {
                         snprintf(display_label, sizeof(display_label), "%s", label);
                     }
                 }
-                XftDrawStringUtf8(canvas->xft_draw, &item_fg, font, 10, item_y + y_base, (FcChar8 *)display_label, strlen(display_label));
+                XftDrawStringUtf8(canvas->xft_draw, item_fg, font, 10, item_y + y_base, (FcChar8 *)display_label, strlen(display_label));
             } else {
                 // Regular menu item, no modification
-                XftDrawStringUtf8(canvas->xft_draw, &item_fg, font, 10, item_y + y_base, (FcChar8 *)label, strlen(label));
+                XftDrawStringUtf8(canvas->xft_draw, item_fg, font, 10, item_y + y_base, (FcChar8 *)label, strlen(label));
             }
 
             // Draw checkmark after label if this item has one
             if (has_checkmark) {
                 XGlyphInfo label_extents;
-                XftTextExtentsUtf8(ctx->dpy, font, (FcChar8 *)label, strlen(label), &label_extents);
+                font_manager_text_extents(font, label, &label_extents);
 
                 // Position checkmark 1 character space after the label
                 int checkmark_x = 10 + label_extents.xOff + 10;  // 10px gap after label
-                XftDrawStringUtf8(canvas->xft_draw, &item_fg, font, checkmark_x, item_y + y_base,
+                XftDrawStringUtf8(canvas->xft_draw, item_fg, font, checkmark_x, item_y + y_base,
                                 (FcChar8 *)CHECKMARK, strlen(CHECKMARK));
             }
 
@@ -333,26 +356,23 @@ static void render_menu_content(Canvas *canvas, RenderContext *ctx) {
                 }
                 
                 XGlyphInfo shortcut_extents;
-                XftTextExtentsUtf8(ctx->dpy, font, (FcChar8 *)shortcut_text, strlen(shortcut_text), &shortcut_extents);
+                font_manager_text_extents(font, shortcut_text, &shortcut_extents);
                 
                 // Right-align shortcut with 1 char padding from right edge
                 int shortcut_x = canvas->width - shortcut_extents.xOff - 10;  // 10 pixels padding from right
-                XftDrawStringUtf8(canvas->xft_draw, &item_fg, font, shortcut_x, item_y + y_base, (FcChar8 *)shortcut_text, strlen(shortcut_text));
+                XftDrawStringUtf8(canvas->xft_draw, item_fg, font, shortcut_x, item_y + y_base, (FcChar8 *)shortcut_text, strlen(shortcut_text));
             }
             
             // Draw ">>" indicator for items that have submenus
             if (menu->submenus && menu->submenus[i]) {
                 const char *submenu_indicator = ">>";
                 XGlyphInfo indicator_extents;
-                XftTextExtentsUtf8(ctx->dpy, font, (FcChar8 *)submenu_indicator, strlen(submenu_indicator), &indicator_extents);
+                font_manager_text_extents(font, submenu_indicator, &indicator_extents);
                 
                 // Right-align indicator with same padding as shortcuts
                 int indicator_x = canvas->width - indicator_extents.xOff - 10;  // 10 pixels padding from right
-                XftDrawStringUtf8(canvas->xft_draw, &item_fg, font, indicator_x, item_y + y_base, (FcChar8 *)submenu_indicator, strlen(submenu_indicator));
+                XftDrawStringUtf8(canvas->xft_draw, item_fg, font, indicator_x, item_y + y_base, (FcChar8 *)submenu_indicator, strlen(submenu_indicator));
             }
-            
-            
-            XftColorFree(ctx->dpy, canvas->visual, canvas->colormap, &item_fg);
         }
     }
     
@@ -386,11 +406,10 @@ static void render_menubar_addons(Canvas *canvas, RenderContext *ctx) {
 
 // Render window title in titlebar
 static void render_window_title(Canvas *canvas, RenderContext *ctx, Picture dest) {
-    // Properly allocate XftColor for title text
-    XftColor text_col;
+    // Title text color comes from the palette (no per-frame allocation)
     bool is_active = (canvas == itn_focus_get_active());
-    XRenderColor render_color = is_active ? WHITE : BLACK;
-    XftColorAllocValue(ctx->dpy, canvas->visual, canvas->colormap, &render_color, &text_col);
+    XftColor *text_col = render_xft_color(canvas->visual, canvas->colormap,
+                                          is_active ? &WHITE : &BLACK);
 
     // Get unified font for title drawing
     XftFont *title_font = get_font();
@@ -418,7 +437,7 @@ static void render_window_title(Canvas *canvas, RenderContext *ctx, Picture dest
         if (canvas->client_win == None) {
             // Workbench windows: draw to buffer using cached XftDraw
             if (canvas->xft_draw) {
-                XftDrawStringUtf8(canvas->xft_draw, &text_col, title_font, 50, text_y-4,
+                XftDrawStringUtf8(canvas->xft_draw, text_col, title_font, 50, text_y-4,
                                 (FcChar8 *)render_title, strlen(render_title));
             }
         } else {
@@ -428,11 +447,10 @@ static void render_window_title(Canvas *canvas, RenderContext *ctx, Picture dest
                 canvas->xft_draw = XftDrawCreate(ctx->dpy, canvas->win, canvas->visual, canvas->colormap);
             }
             if (canvas->xft_draw) {
-                XftDrawStringUtf8(canvas->xft_draw, &text_col, title_font, 50, text_y-4,
+                XftDrawStringUtf8(canvas->xft_draw, text_col, title_font, 50, text_y-4,
                                 (FcChar8 *)render_title, strlen(render_title));
             }
         }
-        XftColorFree(ctx->dpy, canvas->visual, canvas->colormap, &text_col);
     }
 }
 
@@ -482,11 +500,15 @@ static void render_scrollbar_knobs(Canvas *canvas, RenderContext *ctx, Picture d
 
 
 // Dispatch rendering based on canvas type
+// strip: NULL renders the whole content area. Otherwise only icons touching
+// the strip (canvas coordinates, already clipped by the caller) are drawn -
+// an empty strip skips icons entirely (frame-only refresh).
 static void render_canvas_content(Canvas *canvas, RenderContext *ctx, Picture dest,
-                                  bool is_client_frame) {
+                                  bool is_client_frame, const XRectangle *strip) {
     // Render icons for desktop and window canvases
     if (!is_client_frame && !canvas->scanning &&
-        (canvas->type == DESKTOP || canvas->type == WINDOW)) {
+        (canvas->type == DESKTOP || canvas->type == WINDOW) &&
+        (!strip || (strip->width > 0 && strip->height > 0))) {
         FileIcon **icon_array = wb_icons_array_get();
         int icon_count = wb_icons_array_count();
 
@@ -497,16 +519,29 @@ static void render_canvas_content(Canvas *canvas, RenderContext *ctx, Picture de
             (canvas->client_win == None ? BORDER_WIDTH_RIGHT : BORDER_WIDTH_RIGHT_CLIENT));
         int view_bottom = view_top + (canvas->height - BORDER_HEIGHT_TOP - BORDER_HEIGHT_BOTTOM);
 
+        // Strip only: narrow the viewport to it (content coordinates)
+        if (strip) {
+            view_left = canvas->scroll_x + strip->x - BORDER_WIDTH_LEFT;
+            view_top = canvas->scroll_y + strip->y - BORDER_HEIGHT_TOP;
+            view_right = view_left + strip->width;
+            view_bottom = view_top + strip->height;
+        }
+
         // Dispatch to list or grid view
         if (canvas->type == WINDOW && canvas->view_mode == VIEW_NAMES) {
-            render_icons_list_view(canvas, ctx, dest, icon_array, icon_count, view_bottom);
+            render_icons_list_view(canvas, ctx, dest, icon_array, icon_count, view_top, view_bottom);
         } else {
             render_icons_grid_view(canvas, icon_array, icon_count,
                                   view_left, view_right, view_top, view_bottom);
         }
 
-        // Draw multiselection rectangle if active (after icons so it appears on top)
-        wb_draw_multiselection_rect(canvas, canvas->canvas_buffer, canvas->visual);
+    }
+
+    // Frame is drawn unclipped, whatever the strip was
+    if (strip) {
+        XRenderPictureAttributes pa = { .clip_mask = None };
+        XRenderChangePicture(ctx->dpy, dest, CPClipMask, &pa);
+        if (canvas->xft_draw) XftDrawSetClip(canvas->xft_draw, None);
     }
 
     // Render menu content
@@ -521,129 +556,9 @@ static void render_canvas_content(Canvas *canvas, RenderContext *ctx, Picture de
     // Draw frame for WINDOW and DIALOG types BEFORE content (skip when fullscreen)
     if ((canvas->type == WINDOW || canvas->type == DIALOG) && !canvas->fullscreen) {
         bool is_active = (canvas == itn_focus_get_active());
-        XRenderColor frame_color = is_active ? BLUE : GRAY;
-
-        // top border
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &frame_color, 0, 0, canvas->width, BORDER_HEIGHT_TOP);
-
-        // Bottom black line of titlebar
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, 0, 19 , canvas->width, 1);
-
-        // left border
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &frame_color, 0, BORDER_HEIGHT_TOP, BORDER_WIDTH_LEFT, canvas->height - BORDER_HEIGHT_TOP);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, 0, 1, 1, canvas->height - 1);  // Start at y=1 to avoid corner
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, BORDER_WIDTH_LEFT -1, 20, 1, canvas->height);
-
-        // right border
-        // Dialogs and client windows use 8px border, workbench windows use 20px
-        int right_border_width = (canvas->type == DIALOG || canvas->client_win != None) ? BORDER_WIDTH_RIGHT_CLIENT : BORDER_WIDTH_RIGHT;
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &frame_color, canvas->width - right_border_width, BORDER_HEIGHT_TOP, right_border_width, canvas->height - BORDER_HEIGHT_TOP - BORDER_HEIGHT_BOTTOM);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width - right_border_width, 20, 1, canvas->height);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -1, 0, 1, canvas->height);
-
-        // bottom border
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &frame_color, 1, canvas->height - BORDER_HEIGHT_BOTTOM, canvas->width -2 , BORDER_HEIGHT_BOTTOM);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, BORDER_WIDTH_LEFT, canvas->height - BORDER_HEIGHT_BOTTOM, canvas->width -9 , 1);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, 0, canvas->height - 1, canvas->width, 1);
-
-        // top border, close button
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, 29, 1 , 1, BORDER_HEIGHT_TOP-1);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, 30, 1 , 1, BORDER_HEIGHT_TOP-2);
-
-        // Draw close button with its portion of the white line
-        if (canvas->close_armed) {
-            // Sunken effect - black top line instead of white
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, 0, 0, 30, 1);   // Top black line
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, 0, 1, 1, 18);   // Left edge
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, 29, 1, 1, 18);  // Right edge
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, 1, 18, 28, 1);  // Bottom edge
-        } else {
-            // Normal state - draw white line for this button area
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, 0, 0, 30, 1);   // Top white line
-        }
-
-        // Draw button interior (white square)
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, 11, 6 , 8, 8);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, 12, 7 , 6, 6);
-
-        // Title area white line (between close button and right-side buttons)
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, 30, 0, canvas->width - 91 - 30, 1);
-
-        // top border, lower button
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -31, 1 , 1, BORDER_HEIGHT_TOP-1);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -30, 1 , 1, BORDER_HEIGHT_TOP-2);
-
-        if (canvas->lower_armed) {
-            // Sunken effect - black top line instead of white
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -31, 0, 31, 1);   // Top black line
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -31, 1, 1, 18);   // Left edge
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -2, 1, 1, 18);    // Right edge
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -30, 18, 28, 1);  // Bottom edge
-        } else {
-            // Normal state - draw white line for this button area
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -31, 0, 31, 1);   // Top white line
-        }
-
-        // Draw button graphics
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -25, 4 , 15, 8);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &GRAY,  canvas->width -24, 5 , 13, 6);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -20, 7 , 15, 8);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -19, 8 , 13, 6);
-
-        // top border, maximize button
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -61, 1 , 1, BORDER_HEIGHT_TOP-1);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -60, 1 , 1, BORDER_HEIGHT_TOP-2);
-
-        if (canvas->maximize_armed) {
-            // Sunken effect - black top line instead of white
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -61, 0, 30, 1);   // Top black line
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -61, 1, 1, 18);   // Left edge
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -32, 1, 1, 18);   // Right edge
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -60, 18, 28, 1);  // Bottom edge
-        } else {
-            // Normal state - draw white line for this button area
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -61, 0, 30, 1);   // Top white line
-        }
-
-        // Draw button graphics
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -53, 4 , 16, 11);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &frame_color, canvas->width -52, 5 , 14, 9);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -52, 5 , 8, 6);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -51, 5 , 5, 5);
-
-        // top border, iconify button
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -91, 1 , 1, BORDER_HEIGHT_TOP-1);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -90, 1 , 1, BORDER_HEIGHT_TOP-2);
-
-        if (canvas->iconify_armed) {
-            // Sunken effect - black top line instead of white
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -91, 0, 30, 1);   // Top black line
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -91, 1, 1, 18);   // Left edge
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -62, 1, 1, 18);   // Right edge
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -90, 18, 28, 1);  // Bottom edge
-        } else {
-            // Normal state - draw white line for this button area
-            XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -91, 0, 30, 1);   // Top white line
-        }
-
-        // Draw button graphics
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -83, 4 , 16, 11);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest,&frame_color,canvas->width-82, 5 , 14, 9);
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &BLACK, canvas->width -82, 10, 6, 5 );
-        XRenderFillRectangle(ctx->dpy, PictOpSrc, dest, &WHITE, canvas->width -82, 11, 5, 3 );
 
-        // Draw scrollbar arrows for workbench windows only (skip for dialogs)
-        if (canvas->type == WINDOW && canvas->client_win == None && !canvas->disable_scrollbars) {
-            draw_vertical_scrollbar_arrows(ctx->dpy, dest, canvas);
-        }
-
-        // Draw resize button/handle in bottom-right corner
-        draw_resize_button(ctx->dpy, dest, canvas);
-
-        // Draw horizontal scrollbar arrows for workbench windows only (skip for dialogs)
-        if (canvas->type == WINDOW && canvas->client_win == None && !canvas->disable_scrollbars) {
-            draw_horizontal_scrollbar_arrows(ctx->dpy, dest, canvas);
-        }
+        // Borders, gadgets and arrows come from cached templates (rnd_decor.c)
+        draw_window_frame(ctx->dpy, dest, canvas, is_active);
 
         // Draw window title
         if (canvas->title_base || canvas->title_change) {
@@ -704,12 +619,246 @@ void redraw_canvas(Canvas *canvas) {
     }
     
     // Render canvas content (icons, menus, dialogs, decorations)
-    render_canvas_content(canvas, ctx, dest, is_client_frame);
+    render_canvas_content(canvas, ctx, dest, is_client_frame, NULL);
 
     // Composite buffer to window for non-client frames
     if (!is_client_frame) {
         composite_to_window(canvas, ctx);
+        update_selection_overlay(canvas, ctx, false);
+    } else {
+        // Client frames draw straight to the frame window, but XDamage only
+        // watches the client - report the frame ourselves so the compositor
+        // includes the decorations in its repaint region
+        itn_render_accumulate_canvas_damage(canvas);
+        itn_render_schedule_frame();
+    }
+}
+
+// Content scrolled from (old_scroll_x, old_scroll_y) to the canvas's current
+// scroll: move the pixels already in canvas_buffer with XCopyArea and render
+// only the strip that scrolled into view (plus the frame - knobs moved).
+// Cost depends on the strip, not on how many icons the directory has.
+// Falls back to redraw_canvas when the old pixels can't be reused.
+void render_scroll_canvas(Canvas *canvas, int old_scroll_x, int old_scroll_y) {
+    if (!canvas) return;
+
+    RenderContext *ctx = get_render_context();
+    int dx = canvas->scroll_x - old_scroll_x;
+    int dy = canvas->scroll_y - old_scroll_y;
+
+    int cx = BORDER_WIDTH_LEFT;
+    int cy = BORDER_HEIGHT_TOP;
+    int cw = canvas->width - BORDER_WIDTH_LEFT - BORDER_WIDTH_RIGHT;
+    int ch = canvas->height - BORDER_HEIGHT_TOP - BORDER_HEIGHT_BOTTOM;
+
+    // Blit only works when the background scrolls with the content: window
+    // wallpaper stays put, so those windows (and anything odd) redraw fully
+    bool has_wallpaper = (canvas->view_mode == VIEW_ICONS && ctx && ctx->wind_picture != None);
+    if (!ctx || canvas->type != WINDOW || canvas->client_win != None ||
+        canvas->scanning || canvas->resizing_interactive || has_wallpaper ||
+        canvas->canvas_buffer == None || canvas->canvas_render == None ||
+        canvas->window_render == None || cw <= 0 || ch <= 0 ||
+        (dx && dy) || abs(dx) >= cw || abs(dy) >= ch ||
+        wb_is_multiselecting(canvas) || itn_resize_get_target()) {
+        redraw_canvas(canvas);
+        return;
+    }
+
+    // Move the still-visible part of the content (XCopyArea handles overlap)
+    XRectangle strip = {0, 0, 0, 0};
+    if (dx || dy) {
+        GC gc = XCreateGC(ctx->dpy, canvas->canvas_buffer, 0, NULL);
+        XSetGraphicsExposures(ctx->dpy, gc, False);
+        XCopyArea(ctx->dpy, canvas->canvas_buffer, canvas->canvas_buffer, gc,
+                  cx + max(dx, 0), cy + max(dy, 0), cw - abs(dx), ch - abs(dy),
+                  cx + max(-dx, 0), cy + max(-dy, 0));
+        XFreeGC(ctx->dpy, gc);
+
+        // Newly exposed strip on the side we scrolled towards
+        if (dy > 0)      strip = (XRectangle){cx, cy + ch - dy, cw, dy};
+        else if (dy < 0) strip = (XRectangle){cx, cy, cw, -dy};
+        else if (dx > 0) strip = (XRectangle){cx + cw - dx, cy, dx, ch};
+        else             strip = (XRectangle){cx, cy, -dx, ch};
+
+        // Clip background and icons to the strip
+        XRenderSetPictureClipRectangles(ctx->dpy, canvas->canvas_render, 0, 0, &strip, 1);
+        if (canvas->xft_draw) XftDrawSetClipRectangles(canvas->xft_draw, 0, 0, &strip, 1);
+        render_background(canvas, ctx, canvas->canvas_render);
+    }
+
+    render_canvas_content(canvas, ctx, canvas->canvas_render, false, &strip);
+    composite_to_window(canvas, ctx);
+    update_selection_overlay(canvas, ctx, false);
+}
+
+// ============================================================================
+// Retained Icon Redraw
+// ============================================================================
+
+#define RETAINED_MAX_RECTS 64   // More dirty rects than this: full redraw
+
+// Has the icon changed since render_icon / the list row last drew it?
+static bool icon_changed(FileIcon *icon) {
+    const IconDrawnState *d = &icon->drawn;
+    return d->picture != icon->current_picture || d->selected != icon->selected ||
+           d->x != icon->x || d->y != icon->y ||
+           d->label_hash != render_label_hash(icon->label);
+}
+
+// Content rectangle to canvas coordinates, clipped to the content area
+// Returns false if nothing of it is visible
+static bool content_rect_to_canvas(Canvas *canvas, int x, int y, int w, int h, XRectangle *out) {
+    int base_x = (canvas->type == WINDOW) ? BORDER_WIDTH_LEFT : 0;
+    int base_y = (canvas->type == WINDOW) ? BORDER_HEIGHT_TOP : 0;
+    int left = base_x, top = base_y;
+    int right = canvas->width, bottom = canvas->height;
+    if (canvas->type == WINDOW) {
+        right -= BORDER_WIDTH_RIGHT;
+        bottom -= BORDER_HEIGHT_BOTTOM;
+    }
+
+    int x1 = max(left, base_x + x - canvas->scroll_x);
+    int y1 = max(top, base_y + y - canvas->scroll_y);
+    int x2 = min(right, base_x + x - canvas->scroll_x + w);
+    int y2 = min(bottom, base_y + y - canvas->scroll_y + h);
+    if (x2 <= x1 || y2 <= y1) return false;
+
+    *out = (XRectangle){x1, y1, x2 - x1, y2 - y1};
+    return true;
+}
+
+static bool hits_any(const XRectangle *r, const XRectangle *rects, int count) {
+    for (int i = 0; i < count; i++) {
+        if (r->x < rects[i].x + rects[i].width && rects[i].x < r->x + r->width &&
+            r->y < rects[i].y + rects[i].height && rects[i].y < r->y + r->height) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Canvas area an icon covers: as last drawn (drawn = true) or as it is now
+static bool icon_canvas_rect(Canvas *canvas, FileIcon *icon, bool drawn,
+                             bool list_view, int row_h, XRectangle *out) {
+    int x, y, w, h;
+    if (list_view) {
+        // Rows span the viewport width whatever the label
+        x = canvas->scroll_x;
+        y = drawn ? icon->drawn.rect_y : icon->y;
+        w = canvas->width - BORDER_WIDTH_LEFT - BORDER_WIDTH_RIGHT;
+        h = row_h;
+    } else if (drawn) {
+        x = icon->drawn.rect_x;
+        y = icon->drawn.rect_y;
+        w = icon->drawn.rect_w;
+        h = icon->drawn.rect_h;
+    } else {
+        render_icon_bounds(icon, &x, &y, &w, &h);
+    }
+    return content_rect_to_canvas(canvas, x, y, w, h, out);
+}
+
+// Retained redraw: re-render only the icons whose look changed since they
+// were last drawn (selection, label, position, new arrivals) and the
+// background under their old and new rectangles. Icons overlapping those
+// rectangles are redrawn clipped so stacking stays the same as a full
+// redraw; everything else in canvas_buffer is reused, and only the dirty
+// rectangles are copied to the window (XDamage reports just those).
+// Removed icons and relayouts still need redraw_canvas.
+// with_frame: also refresh the frame (scrollbar knobs after content changes)
+void redraw_canvas_icons(Canvas *canvas, bool with_frame) {
+    RenderContext *ctx = get_render_context();
+    if (!canvas || !ctx || canvas->client_win != None ||
+        (canvas->type != WINDOW && canvas->type != DESKTOP) ||
+        canvas->scanning || canvas->resizing_interactive || itn_resize_get_target() ||
+        canvas->canvas_render == None || canvas->window_render == None ||
+        !canvas->xft_draw) {
+        redraw_canvas(canvas);
+        return;
+    }
+
+    bool list_view = (canvas->type == WINDOW && canvas->view_mode == VIEW_NAMES);
+    XftFont *font = get_font();
+    if (list_view && !font) {
+        redraw_canvas(canvas);
+        return;
+    }
+    int row_h = font ? font->ascent + font->descent + 6 : 0;
+
+    FileIcon **icons = wb_icons_array_get();
+    int count = wb_icons_array_count();
+
+    // Old and new rectangle of every changed icon
+    XRectangle dirty[RETAINED_MAX_RECTS];
+    int dirty_count = 0;
+    for (int i = 0; i < count; i++) {
+        FileIcon *icon = icons[i];
+        if (!icon || icon->display_window != canvas->win || !icon_changed(icon)) continue;
+
+        if (dirty_count + 2 > RETAINED_MAX_RECTS) {
+            redraw_canvas(canvas);
+            return;
+        }
+        if (icon->drawn.picture != None &&
+            icon_canvas_rect(canvas, icon, true, list_view, row_h, &dirty[dirty_count])) {
+            dirty_count++;
+        }
+        if (icon_canvas_rect(canvas, icon, false, list_view, row_h, &dirty[dirty_count])) {
+            dirty_count++;
+        }
+    }
+
+    if (dirty_count > 0) {
+        Picture dest = canvas->canvas_render;
+        XRenderSetPictureClipRectangles(ctx->dpy, dest, 0, 0, dirty, dirty_count);
+        XftDrawSetClipRectangles(canvas->xft_draw, 0, 0, dirty, dirty_count);
+        render_background(canvas, ctx, dest);
+
+        XftColor *white_col = render_xft_color(canvas->visual, canvas->colormap, &WHITE);
+        XftColor *normal_col = render_xft_color(canvas->visual, canvas->colormap, &WINFONTCOL);
+        int max_row_w = canvas->width - BORDER_WIDTH_LEFT - BORDER_WIDTH_RIGHT;
+
+        // Changed icons, and unchanged ones whose drawn pixels were cleared
+        for (int i = 0; i < count; i++) {
+            FileIcon *icon = icons[i];
+            if (!icon || icon->display_window != canvas->win) continue;
+
+            XRectangle r;
+            bool changed = icon_changed(icon);
+            if (!icon_canvas_rect(canvas, icon, !changed, list_view, row_h, &r) ||
+                !hits_any(&r, dirty, dirty_count)) {
+                continue;
+            }
+
+            if (list_view) {
+                render_list_view_row(canvas, ctx, dest, icon, font,
+                                     BORDER_HEIGHT_TOP + icon->y - canvas->scroll_y,
+                                     row_h, max_row_w, white_col, normal_col);
+            } else {
+                render_icon(icon, canvas);
+            }
+        }
+
+        XRenderPictureAttributes pa = { .clip_mask = None };
+        XRenderChangePicture(ctx->dpy, dest, CPClipMask, &pa);
+        XftDrawSetClip(canvas->xft_draw, None);
+    }
+
+    if (with_frame && canvas->type == WINDOW) {
+        // Empty strip: frame only, then one full copy
+        XRectangle none = {0, 0, 0, 0};
+        render_canvas_content(canvas, ctx, canvas->canvas_render, false, &none);
+        composite_to_window(canvas, ctx);
+        update_selection_overlay(canvas, ctx, false);
+        return;
+    }
+
+    for (int i = 0; i < dirty_count; i++) {
+        XRenderComposite(ctx->dpy, PictOpSrc, canvas->canvas_render, None,
+                         canvas->window_render, dirty[i].x, dirty[i].y, 0, 0,
+                         dirty[i].x, dirty[i].y, dirty[i].width, dirty[i].height);
     }
+    update_selection_overlay(canvas, ctx, true);
 }
 
 // ============================================================================
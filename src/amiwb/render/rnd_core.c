@@ -6,11 +6,29 @@
 #include "../intuition/itn_public.h"
 #include "../font_manager.h"
 #include <X11/Xft/Xft.h>
+#include <stdlib.h>
 
 // Global UI colors (private to module)
 static XftColor text_color_black;
 static XftColor text_color_white;
 
+// XftColor palette - every (visual, colormap, RGBA) allocated once
+// Entries are individually allocated so handed-out pointers stay valid
+// while the palette grows. Canvases own their colormaps, so entries are
+// dropped per colormap when a canvas goes away.
+#define PALETTE_BUCKETS 64
+
+typedef struct PaletteEntry {
+    Visual *visual;
+    Colormap colormap;
+    XRenderColor value;
+    XftColor color;
+    struct PaletteEntry *next;
+} PaletteEntry;
+
+static PaletteEntry *palette[PALETTE_BUCKETS];
+static XftColor palette_fallback;   // Pixel 0 if an allocation fails
+
 // Initialize rendering resources. Requires RenderContext from
 // init_intuition(). If font is not ready yet, callers should guard
 // text drawing (redraw_canvas() already does).
@@ -47,6 +65,12 @@ void cleanup_render(void) {
     RenderContext *ctx = get_render_context();
     if (!ctx) return;
 
+    // Clean up cached frame decoration templates
+    cleanup_frame_cache();
+
+    // Release cached text colors
+    render_palette_release(None);
+
     // Clean up cached checkerboard patterns
     if (ctx->checker_active_picture != None) {
         XRenderFreePicture(ctx->dpy, ctx->checker_active_picture);
@@ -77,6 +101,70 @@ void cleanup_render(void) {
     // Cleanup render resources
 }
 
+// ============================================================================
+// XftColor Palette
+// ============================================================================
+
+static unsigned palette_bucket(Colormap colormap, const XRenderColor *v) {
+    unsigned h = (unsigned)colormap * 31u;
+    h = (h ^ v->red) * 16777619u;
+    h = (h ^ v->green) * 16777619u;
+    h = (h ^ v->blue) * 16777619u;
+    h = (h ^ v->alpha) * 16777619u;
+    return h % PALETTE_BUCKETS;
+}
+
+// Cached XftColor for drawing text in (visual, colormap). Allocated on first
+// use - a server round trip on non-TrueColor or remote displays - and kept
+// until the colormap is released. Never free it; never NULL.
+XftColor *render_xft_color(Visual *visual, Colormap colormap, const XRenderColor *value) {
+    RenderContext *ctx = get_render_context();
+    if (!ctx || !value) return &palette_fallback;
+
+    unsigned b = palette_bucket(colormap, value);
+    for (PaletteEntry *e = palette[b]; e; e = e->next) {
+        if (e->visual == visual && e->colormap == colormap &&
+            e->value.red == value->red && e->value.green == value->green &&
+            e->value.blue == value->blue && e->value.alpha == value->alpha) {
+            return &e->color;
+        }
+    }
+
+    PaletteEntry *e = calloc(1, sizeof(PaletteEntry));
+    if (!e) return &palette_fallback;
+    if (!XftColorAllocValue(ctx->dpy, visual, colormap, value, &e->color)) {
+        log_error("[PALETTE] XftColorAllocValue failed (%04x,%04x,%04x)",
+                  value->red, value->green, value->blue);
+        free(e);
+        return &palette_fallback;
+    }
+    e->visual = visual;
+    e->colormap = colormap;
+    e->value = *value;
+    e->next = palette[b];
+    palette[b] = e;
+    return &e->color;
+}
+
+// Free the colors of one colormap (call before XFreeColormap)
+// colormap None: free everything (render cleanup)
+void render_palette_release(Colormap colormap) {
+    RenderContext *ctx = get_render_context();
+    for (int b = 0; b < PALETTE_BUCKETS; b++) {
+        PaletteEntry **link = &palette[b];
+        while (*link) {
+            PaletteEntry *e = *link;
+            if (colormap != None && e->colormap != colormap) {
+                link = &e->next;
+                continue;
+            }
+            if (ctx && ctx->dpy) XftColorFree(ctx->dpy, e->visual, e->colormap, &e->color);
+            *link = e->next;
+            free(e);
+        }
+    }
+}
+
 // Get width in pixels of UTF-8 text string
 int get_text_width(const char *text) {
     return font_manager_text_width(text);
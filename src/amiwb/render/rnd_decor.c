@@ -0,0 +1,400 @@
+// File: rnd_decor.c
+// Cached window frame decorations (borders, title bar gadgets, scrollbar arrows)
+// The frame used to be rebuilt from ~70 XRenderFillRectangle calls on every
+// redraw. Every frame of a given state (active/inactive, border kind, armed
+// gadgets) has the same pixels except for the stretchable middle runs, so
+// one small template frame is drawn per state and real frames are assembled
+// from its pieces: fixed corners/gadget strips plus 1px edge slices that are
+// tiled with RepeatNormal - nine composites instead of the fills.
+// Title text and scrollbar knobs change per window and are drawn on top by
+// rnd_canvas.c as before.
+
+#include "rnd_internal.h"
+#include <X11/Xlib.h>
+#include <X11/extensions/Xrender.h>
+#include <string.h>
+
+// ============================================================================
+// Template Geometry
+// ============================================================================
+
+// Fixed pieces, measured from the edges the fill code draws relative to
+#define DECOR_LEFT 32           // Close gadget plus its white/black separators
+#define DECOR_RIGHT 92          // Iconify, maximize and lower gadgets (w-91..w)
+#define DECOR_BL 9              // Left border part of the bottom border
+#define DECOR_BR_ARROWS 64      // Horizontal arrows and resize (w-62..w)
+#define DECOR_BR_PLAIN 22       // Resize gadget only (w-21..w)
+#define DECOR_V_ARROWS 41       // Vertical arrows above the bottom border
+
+// One stretchable pixel between the fixed pieces in each direction
+#define DECOR_TEMPLATE_W (DECOR_LEFT + 1 + DECOR_RIGHT)
+#define DECOR_TEMPLATE_H (BORDER_HEIGHT_TOP + 1 + DECOR_V_ARROWS + BORDER_HEIGHT_BOTTOM)
+
+// Smaller frames than the template are drawn with the fills directly
+#define DECOR_MIN_W DECOR_TEMPLATE_W
+#define DECOR_MIN_H DECOR_TEMPLATE_H
+
+#define DECOR_CACHE_SIZE 16     // Templates kept (states seen at the same time)
+
+// Frame kinds - they differ in right border width and scrollbar gadgets
+typedef enum {
+    DECOR_CLIENT = 0,           // Client windows and dialogs: 8px right border
+    DECOR_WORKBENCH,            // Workbench window with scrollbar arrows
+    DECOR_WORKBENCH_PLAIN       // Workbench window with scrollbars disabled
+} DecorKind;
+
+// Key bits: active, kind, armed gadgets
+#define DECOR_KEY_ACTIVE        (1u << 0)
+#define DECOR_KEY_KIND_SHIFT    1
+#define DECOR_KEY_CLOSE         (1u << 3)
+#define DECOR_KEY_ICONIFY       (1u << 4)
+#define DECOR_KEY_MAXIMIZE      (1u << 5)
+#define DECOR_KEY_LOWER         (1u << 6)
+#define DECOR_KEY_V_UP          (1u << 7)
+#define DECOR_KEY_V_DOWN        (1u << 8)
+#define DECOR_KEY_H_LEFT        (1u << 9)
+#define DECOR_KEY_H_RIGHT       (1u << 10)
+#define DECOR_KEY_RESIZE        (1u << 11)
+
+// ============================================================================
+// Module-Private State
+// ============================================================================
+
+typedef struct {
+    bool used;
+    unsigned key;
+    unsigned long last_use;
+    Pixmap pixmap;              // Whole template frame
+    Picture picture;
+    Pixmap slice_pixmaps[4];
+    Picture top;                // 1 x BORDER_HEIGHT_TOP, title bar run
+    Picture bottom;             // 1 x BORDER_HEIGHT_BOTTOM, bottom border run
+    Picture left;               // BORDER_WIDTH_LEFT x 1, left border run
+    Picture right;              // right border width x 1, right border run
+} DecorTemplate;
+
+static DecorTemplate g_templates[DECOR_CACHE_SIZE];
+static unsigned long g_use_counter = 0;
+
+// ============================================================================
+// Frame Drawing
+// ============================================================================
+
+// Draw the frame with fills - the reference the templates are made from,
+// and the path for frames smaller than the template
+static void draw_frame_fills(Display *dpy, Picture dest, Canvas *canvas, bool is_active) {
+    XRenderColor frame_color = is_active ? BLUE : GRAY;
+
+    // top border
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &frame_color, 0, 0, canvas->width, BORDER_HEIGHT_TOP);
+
+    // Bottom black line of titlebar
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, 0, 19 , canvas->width, 1);
+
+    // left border
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &frame_color, 0, BORDER_HEIGHT_TOP, BORDER_WIDTH_LEFT, canvas->height - BORDER_HEIGHT_TOP);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, 0, 1, 1, canvas->height - 1);  // Start at y=1 to avoid corner
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, BORDER_WIDTH_LEFT -1, 20, 1, canvas->height);
+
+    // right border
+    // Dialogs and client windows use 8px border, workbench windows use 20px
+    int right_border_width = (canvas->type == DIALOG || canvas->client_win != None) ? BORDER_WIDTH_RIGHT_CLIENT : BORDER_WIDTH_RIGHT;
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &frame_color, canvas->width - right_border_width, BORDER_HEIGHT_TOP, right_border_width, canvas->height - BORDER_HEIGHT_TOP - BORDER_HEIGHT_BOTTOM);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width - right_border_width, 20, 1, canvas->height);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -1, 0, 1, canvas->height);
+
+    // bottom border
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &frame_color, 1, canvas->height - BORDER_HEIGHT_BOTTOM, canvas->width -2 , BORDER_HEIGHT_BOTTOM);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, BORDER_WIDTH_LEFT, canvas->height - BORDER_HEIGHT_BOTTOM, canvas->width -9 , 1);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, 0, canvas->height - 1, canvas->width, 1);
+
+    // top border, close button
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, 29, 1 , 1, BORDER_HEIGHT_TOP-1);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, 30, 1 , 1, BORDER_HEIGHT_TOP-2);
+
+    // Draw close button with its portion of the white line
+    if (canvas->close_armed) {
+        // Sunken effect - black top line instead of white
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, 0, 0, 30, 1);   // Top black line
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, 0, 1, 1, 18);   // Left edge
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, 29, 1, 1, 18);  // Right edge
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, 1, 18, 28, 1);  // Bottom edge
+    } else {
+        // Normal state - draw white line for this button area
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, 0, 0, 30, 1);   // Top white line
+    }
+
+    // Draw button interior (white square)
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, 11, 6 , 8, 8);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, 12, 7 , 6, 6);
+
+    // Title area white line (between close button and right-side buttons)
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, 30, 0, canvas->width - 91 - 30, 1);
+
+    // top border, lower button
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -31, 1 , 1, BORDER_HEIGHT_TOP-1);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -30, 1 , 1, BORDER_HEIGHT_TOP-2);
+
+    if (canvas->lower_armed) {
+        // Sunken effect - black top line instead of white
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -31, 0, 31, 1);   // Top black line
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -31, 1, 1, 18);   // Left edge
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -2, 1, 1, 18);    // Right edge
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -30, 18, 28, 1);  // Bottom edge
+    } else {
+        // Normal state - draw white line for this button area
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -31, 0, 31, 1);   // Top white line
+    }
+
+    // Draw button graphics
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -25, 4 , 15, 8);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &GRAY,  canvas->width -24, 5 , 13, 6);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -20, 7 , 15, 8);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -19, 8 , 13, 6);
+
+    // top border, maximize button
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -61, 1 , 1, BORDER_HEIGHT_TOP-1);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -60, 1 , 1, BORDER_HEIGHT_TOP-2);
+
+    if (canvas->maximize_armed) {
+        // Sunken effect - black top line instead of white
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -61, 0, 30, 1);   // Top black line
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -61, 1, 1, 18);   // Left edge
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -32, 1, 1, 18);   // Right edge
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -60, 18, 28, 1);  // Bottom edge
+    } else {
+        // Normal state - draw white line for this button area
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -61, 0, 30, 1);   // Top white line
+    }
+
+    // Draw button graphics
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -53, 4 , 16, 11);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &frame_color, canvas->width -52, 5 , 14, 9);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -52, 5 , 8, 6);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -51, 5 , 5, 5);
+
+    // top border, iconify button
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -91, 1 , 1, BORDER_HEIGHT_TOP-1);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -90, 1 , 1, BORDER_HEIGHT_TOP-2);
+
+    if (canvas->iconify_armed) {
+        // Sunken effect - black top line instead of white
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -91, 0, 30, 1);   // Top black line
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -91, 1, 1, 18);   // Left edge
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -62, 1, 1, 18);   // Right edge
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -90, 18, 28, 1);  // Bottom edge
+    } else {
+        // Normal state - draw white line for this button area
+        XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -91, 0, 30, 1);   // Top white line
+    }
+
+    // Draw button graphics
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -83, 4 , 16, 11);
+    XRenderFillRectangle(dpy, PictOpSrc, dest,&frame_color,canvas->width-82, 5 , 14, 9);
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &BLACK, canvas->width -82, 10, 6, 5 );
+    XRenderFillRectangle(dpy, PictOpSrc, dest, &WHITE, canvas->width -82, 11, 5, 3 );
+
+    // Draw scrollbar arrows for workbench windows only (skip for dialogs)
+    if (canvas->type == WINDOW && canvas->client_win == None && !canvas->disable_scrollbars) {
+        draw_vertical_scrollbar_arrows(dpy, dest, canvas);
+    }
+
+    // Draw resize button/handle in bottom-right corner
+    draw_resize_button(dpy, dest, canvas);
+
+    // Draw horizontal scrollbar arrows for workbench windows only (skip for dialogs)
+    if (canvas->type == WINDOW && canvas->client_win == None && !canvas->disable_scrollbars) {
+        draw_horizontal_scrollbar_arrows(dpy, dest, canvas);
+    }
+}
+
+// ============================================================================
+// Template Cache
+// ============================================================================
+
+static DecorKind frame_kind(Canvas *canvas) {
+    if (canvas->type == DIALOG || canvas->client_win != None) return DECOR_CLIENT;
+    return canvas->disable_scrollbars ? DECOR_WORKBENCH_PLAIN : DECOR_WORKBENCH;
+}
+
+static int kind_right_width(DecorKind kind) {
+    return kind == DECOR_CLIENT ? BORDER_WIDTH_RIGHT_CLIENT : BORDER_WIDTH_RIGHT;
+}
+
+// Everything the fill code looks at, packed into one key
+// (scrollbar arrow states only matter where the arrows are drawn)
+static unsigned frame_key(Canvas *canvas, bool is_active) {
+    DecorKind kind = frame_kind(canvas);
+    unsigned key = (unsigned)kind << DECOR_KEY_KIND_SHIFT;
+    if (is_active) key |= DECOR_KEY_ACTIVE;
+    if (canvas->close_armed) key |= DECOR_KEY_CLOSE;
+    if (canvas->iconify_armed) key |= DECOR_KEY_ICONIFY;
+    if (canvas->maximize_armed) key |= DECOR_KEY_MAXIMIZE;
+    if (canvas->lower_armed) key |= DECOR_KEY_LOWER;
+    if (canvas->resize_armed) key |= DECOR_KEY_RESIZE;
+    if (kind == DECOR_WORKBENCH) {
+        if (canvas->v_arrow_up_armed) key |= DECOR_KEY_V_UP;
+        if (canvas->v_arrow_down_armed) key |= DECOR_KEY_V_DOWN;
+        if (canvas->h_arrow_left_armed) key |= DECOR_KEY_H_LEFT;
+        if (canvas->h_arrow_right_armed) key |= DECOR_KEY_H_RIGHT;
+    }
+    return key;
+}
+
+// Template-sized stand-in canvas carrying only the state in the key
+static void template_canvas(unsigned key, Canvas *c) {
+    memset(c, 0, sizeof(*c));
+    DecorKind kind = (DecorKind)((key >> DECOR_KEY_KIND_SHIFT) & 3);
+    c->type = (kind == DECOR_CLIENT) ? DIALOG : WINDOW;
+    c->client_win = None;
+    c->disable_scrollbars = (kind == DECOR_WORKBENCH_PLAIN);
+    c->width = DECOR_TEMPLATE_W;
+    c->height = DECOR_TEMPLATE_H;
+    c->close_armed = (key & DECOR_KEY_CLOSE) != 0;
+    c->iconify_armed = (key & DECOR_KEY_ICONIFY) != 0;
+    c->maximize_armed = (key & DECOR_KEY_MAXIMIZE) != 0;
+    c->lower_armed = (key & DECOR_KEY_LOWER) != 0;
+    c->resize_armed = (key & DECOR_KEY_RESIZE) != 0;
+    c->v_arrow_up_armed = (key & DECOR_KEY_V_UP) != 0;
+    c->v_arrow_down_armed = (key & DECOR_KEY_V_DOWN) != 0;
+    c->h_arrow_left_armed = (key & DECOR_KEY_H_LEFT) != 0;
+    c->h_arrow_right_armed = (key & DECOR_KEY_H_RIGHT) != 0;
+}
+
+static void free_template(Display *dpy, DecorTemplate *t) {
+    Picture *slices[4] = { &t->top, &t->bottom, &t->left, &t->right };
+    for (int i = 0; i < 4; i++) {
+        if (*slices[i] != None) XRenderFreePicture(dpy, *slices[i]);
+        if (t->slice_pixmaps[i] != None) XFreePixmap(dpy, t->slice_pixmaps[i]);
+    }
+    if (t->picture != None) XRenderFreePicture(dpy, t->picture);
+    if (t->pixmap != None) XFreePixmap(dpy, t->pixmap);
+    memset(t, 0, sizeof(*t));
+}
+
+// Copy a 1px run out of the template into its own repeating picture
+static Picture make_slice(RenderContext *ctx, XRenderPictFormat *fmt, Picture src,
+                          int sx, int sy, int w, int h, Pixmap *pixmap_out) {
+    Display *dpy = ctx->dpy;
+    *pixmap_out = XCreatePixmap(dpy, DefaultRootWindow(dpy), w, h,
+                                DefaultDepth(dpy, ctx->default_screen));
+    if (*pixmap_out == None) return None;
+
+    XRenderPictureAttributes pa = { .repeat = RepeatNormal };
+    Picture slice = XRenderCreatePicture(dpy, *pixmap_out, fmt, CPRepeat, &pa);
+    XRenderComposite(dpy, PictOpSrc, src, None, slice, sx, sy, 0, 0, 0, 0, w, h);
+    return slice;
+}
+
+static bool build_template(RenderContext *ctx, DecorTemplate *t, unsigned key) {
+    Display *dpy = ctx->dpy;
+    XRenderPictFormat *fmt = XRenderFindVisualFormat(dpy, ctx->default_visual);
+    if (!fmt) return false;
+
+    t->pixmap = XCreatePixmap(dpy, DefaultRootWindow(dpy), DECOR_TEMPLATE_W, DECOR_TEMPLATE_H,
+                              DefaultDepth(dpy, ctx->default_screen));
+    if (t->pixmap == None) return false;
+    t->picture = XRenderCreatePicture(dpy, t->pixmap, fmt, 0, NULL);
+
+    Canvas tmpl;
+    template_canvas(key, &tmpl);
+    draw_frame_fills(dpy, t->picture, &tmpl, (key & DECOR_KEY_ACTIVE) != 0);
+
+    int right_width = kind_right_width(frame_kind(&tmpl));
+    t->top = make_slice(ctx, fmt, t->picture, DECOR_LEFT, 0,
+                        1, BORDER_HEIGHT_TOP, &t->slice_pixmaps[0]);
+    t->bottom = make_slice(ctx, fmt, t->picture, DECOR_BL, DECOR_TEMPLATE_H - BORDER_HEIGHT_BOTTOM,
+                           1, BORDER_HEIGHT_BOTTOM, &t->slice_pixmaps[1]);
+    t->left = make_slice(ctx, fmt, t->picture, 0, BORDER_HEIGHT_TOP,
+                         BORDER_WIDTH_LEFT, 1, &t->slice_pixmaps[2]);
+    t->right = make_slice(ctx, fmt, t->picture, DECOR_TEMPLATE_W - right_width, BORDER_HEIGHT_TOP,
+                          right_width, 1, &t->slice_pixmaps[3]);
+    if (t->top == None || t->bottom == None || t->left == None || t->right == None) {
+        free_template(dpy, t);
+        return false;
+    }
+
+    t->used = true;
+    t->key = key;
+    return true;
+}
+
+// Cached template for key, built on first use (least recently used is evicted)
+static DecorTemplate *get_template(RenderContext *ctx, unsigned key) {
+    DecorTemplate *slot = NULL;
+    for (int i = 0; i < DECOR_CACHE_SIZE; i++) {
+        DecorTemplate *t = &g_templates[i];
+        if (t->used && t->key == key) {
+            t->last_use = ++g_use_counter;
+            return t;
+        }
+        // Prefer a free slot, otherwise the oldest one
+        if (!slot || (slot->used && (!t->used || t->last_use < slot->last_use))) {
+            slot = t;
+        }
+    }
+
+    if (slot->used) free_template(ctx->dpy, slot);
+    if (!build_template(ctx, slot, key)) return NULL;
+    slot->last_use = ++g_use_counter;
+    return slot;
+}
+
+static void put(Display *dpy, Picture src, Picture dest, int sx, int sy,
+                int dx, int dy, int w, int h) {
+    if (w <= 0 || h <= 0) return;
+    XRenderComposite(dpy, PictOpSrc, src, None, dest, sx, sy, 0, 0, dx, dy, w, h);
+}
+
+// ============================================================================
+// Internal API (rnd_canvas.c)
+// ============================================================================
+
+// Draw borders, title bar gadgets, scrollbar arrows and resize gadget
+void draw_window_frame(Display *dpy, Picture dest, Canvas *canvas, bool is_active) {
+    RenderContext *ctx = get_render_context();
+    DecorTemplate *t = NULL;
+    if (ctx && canvas->width >= DECOR_MIN_W && canvas->height >= DECOR_MIN_H) {
+        t = get_template(ctx, frame_key(canvas, is_active));
+    }
+    if (!t) {
+        draw_frame_fills(dpy, dest, canvas, is_active);
+        return;
+    }
+
+    DecorKind kind = frame_kind(canvas);
+    int w = canvas->width, h = canvas->height;
+    int right_width = kind_right_width(kind);
+    int br_width = (kind == DECOR_WORKBENCH) ? DECOR_BR_ARROWS : DECOR_BR_PLAIN;
+    int v_arrows = (kind == DECOR_WORKBENCH) ? DECOR_V_ARROWS : 0;
+    int top = BORDER_HEIGHT_TOP, bottom = BORDER_HEIGHT_BOTTOM;
+    int tw = DECOR_TEMPLATE_W, th = DECOR_TEMPLATE_H;
+
+    // Title bar: close gadget, stretched title run, right gadget strip
+    put(dpy, t->picture, dest, 0, 0, 0, 0, DECOR_LEFT, top);
+    put(dpy, t->top, dest, 0, 0, DECOR_LEFT, 0, w - DECOR_LEFT - DECOR_RIGHT, top);
+    put(dpy, t->picture, dest, tw - DECOR_RIGHT, 0, w - DECOR_RIGHT, 0, DECOR_RIGHT, top);
+
+    // Side borders (vertical arrows sit at the bottom of the right one)
+    put(dpy, t->left, dest, 0, 0, 0, top, BORDER_WIDTH_LEFT, h - top - bottom);
+    put(dpy, t->right, dest, 0, 0, w - right_width, top, right_width, h - top - bottom - v_arrows);
+    if (v_arrows) {
+        put(dpy, t->picture, dest, tw - right_width, th - bottom - v_arrows,
+            w - right_width, h - bottom - v_arrows, right_width, v_arrows);
+    }
+
+    // Bottom border: left corner, stretched run, arrows/resize corner
+    put(dpy, t->picture, dest, 0, th - bottom, 0, h - bottom, DECOR_BL, bottom);
+    put(dpy, t->bottom, dest, 0, 0, DECOR_BL, h - bottom, w - DECOR_BL - br_width, bottom);
+    put(dpy, t->picture, dest, tw - br_width, th - bottom, w - br_width, h - bottom, br_width, bottom);
+}
+
+// Drop all templates (render cleanup, before a restart reloads everything)
+void cleanup_frame_cache(void) {
+    RenderContext *ctx = get_render_context();
+    if (!ctx || !ctx->dpy) return;
+    for (int i = 0; i < DECOR_CACHE_SIZE; i++) {
+        if (g_templates[i].used) free_template(ctx->dpy, &g_templates[i]);
+    }
+    g_use_counter = 0;
+}
@@ -7,6 +7,66 @@
 #include "../font_manager.h"
 #include <string.h>
 
+// Content-coordinate rectangle covered by the icon picture and its label
+// (font NULL when no label is drawn). The label box is its advance box
+// joined with the glyph ink box - italic or overhanging glyphs reach past
+// the advance. Both come from the font_manager extents cache.
+static void icon_bounds(FileIcon *icon, XftFont *font, int *x, int *y, int *w, int *h) {
+    int left = icon->x;
+    int top = icon->y;
+    int right = icon->x + (icon->selected ? icon->sel_width : icon->width);
+    int bottom = icon->y + (icon->selected ? icon->sel_height : icon->height);
+
+    if (font) {
+        int label_width = icon_label_width(icon);
+        int text_x = icon->x + (icon->width - label_width) / 2;
+        int text_y = icon->y + icon->height + font->ascent + 2;
+        left = min(left, text_x);
+        right = max(right, text_x + label_width);
+        bottom = max(bottom, text_y + font->descent + 1);
+
+        XGlyphInfo ink;
+        font_manager_text_extents(font, icon->label, &ink);
+        if (ink.width > 0 && ink.height > 0) {
+            left = min(left, text_x - ink.x);
+            right = max(right, text_x - ink.x + ink.width);
+            top = min(top, text_y - ink.y);
+            bottom = max(bottom, text_y - ink.y + ink.height);
+        }
+    }
+
+    *x = left;
+    *y = top;
+    *w = right - left;
+    *h = bottom - top;
+}
+
+// Label contents as a number (FNV-1a) - tells a renamed label from the drawn one
+unsigned render_label_hash(const char *label) {
+    unsigned hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)(label ? label : ""); *p; p++) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    return hash;
+}
+
+// Where render_icon would draw this icon now (content coordinates)
+void render_icon_bounds(FileIcon *icon, int *x, int *y, int *w, int *h) {
+    XftFont *font = icon->label ? font_manager_get() : NULL;
+    icon_bounds(icon, font, x, y, w, h);
+}
+
+// Remember what was drawn so redraw_canvas_icons can tell what changed
+static void record_drawn(FileIcon *icon, XftFont *font) {
+    IconDrawnState *d = &icon->drawn;
+    d->picture = icon->current_picture;
+    d->selected = icon->selected;
+    d->x = icon->x;
+    d->y = icon->y;
+    d->label_hash = render_label_hash(icon->label);
+    icon_bounds(icon, font, &d->rect_x, &d->rect_y, &d->rect_w, &d->rect_h);
+}
+
 // Render a single icon
 void render_icon(FileIcon *icon, Canvas *canvas) {
     //printf("render_icon called\n");
@@ -46,29 +106,29 @@ void render_icon(FileIcon *icon, Canvas *canvas) {
     XftFont *font = font_manager_get();
     if (!font) {
         log_error("[ERROR] render_icon: Font not loaded");
+        record_drawn(icon, NULL);
         return;
     }
     if (!icon->label) {
         log_error("[ERROR] render_icon: No label for icon");
+        record_drawn(icon, NULL);
         return;
     }
 
     // Use cached XftDraw instead of creating a new one
     if (!canvas->xft_draw) {
         log_error("[ERROR] render_icon: No cached XftDraw for label '%s'", icon->label);
+        record_drawn(icon, NULL);
         return;
     }
 
     const char *display_label = icon->label;  // Use full label
 
-    XftColor label_color;
-    XRenderColor render_color = *((canvas->type == DESKTOP) ? &DESKFONTCOL : &WINFONTCOL);
-    XftColorAllocValue(ctx->dpy, canvas->visual, canvas->colormap, &render_color, &label_color);
-    XGlyphInfo extents;
-    XftTextExtentsUtf8(ctx->dpy, font, (FcChar8 *)display_label, strlen(display_label), &extents);
-    int text_x = render_x + (icon->width - extents.xOff) / 2;
+    XftColor *label_color = render_xft_color(canvas->visual, canvas->colormap,
+                                             (canvas->type == DESKTOP) ? &DESKFONTCOL : &WINFONTCOL);
+    int text_x = render_x + (icon->width - icon_label_width(icon)) / 2;
     int text_y = render_y + icon->height + font->ascent + 2;
-    XftDrawStringUtf8(canvas->xft_draw, &label_color, font, text_x, text_y,
+    XftDrawStringUtf8(canvas->xft_draw, label_color, font, text_x, text_y,
                       (FcChar8 *)display_label, strlen(display_label));
-    XftColorFree(ctx->dpy, canvas->visual, canvas->colormap, &label_color);
+    record_drawn(icon, font);
 }
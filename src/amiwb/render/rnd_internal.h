@@ -20,4 +20,12 @@ void draw_resize_button(Display *dpy, Picture dest, Canvas *canvas);
 void create_checkerboard_pattern(RenderContext *ctx);
 void draw_checkerboard(Display *dpy, Picture dest, int x, int y, int w, int h, XRenderColor color1, XRenderColor color2);
 
+// Retained icon state (rnd_icon.c, used by rnd_canvas.c)
+void render_icon_bounds(FileIcon *icon, int *x, int *y, int *w, int *h);
+unsigned render_label_hash(const char *label);
+
+// Window frame decorations, assembled from cached per-state templates (rnd_decor.c)
+void draw_window_frame(Display *dpy, Picture dest, Canvas *canvas, bool is_active);
+void cleanup_frame_cache(void);
+
 #endif // RND_INTERNAL_H
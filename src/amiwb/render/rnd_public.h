@@ -22,6 +22,8 @@ void cleanup_render(void);            // Free render resources safely
 // ============================================================================
 
 void redraw_canvas(Canvas *canvas);   // Redraw full canvas contents
+void render_scroll_canvas(Canvas *canvas, int old_scroll_x, int old_scroll_y); // Blit + exposed strip
+void redraw_canvas_icons(Canvas *canvas, bool with_frame); // Only icons changed since drawn
 
 // ============================================================================
 // Icon Rendering
@@ -36,6 +38,13 @@ void render_icon(FileIcon *icon, Canvas *canvas); // Draw one icon
 int get_text_width(const char *text); // Width in pixels of a UTF-8 string
 XftFont *get_font(void);              // Access the global UI font
 
+// ============================================================================
+// Text Colors
+// ============================================================================
+
+XftColor *render_xft_color(Visual *visual, Colormap colormap, const XRenderColor *value); // Cached, never freed by caller
+void render_palette_release(Colormap colormap); // Drop a colormap's colors (None = all)
+
 // ============================================================================
 // Canvas Surface Management
 // ============================================================================
@@ -10,7 +10,10 @@
 #include <string.h>
 
 // Load image with Imlib2 into a full-screen Pixmap; tile if requested.
-static Pixmap load_wallpaper_to_pixmap(Display *dpy, int screen_num, const char *path, bool tile) {
+// per_output: with several monitors, scale the image into each one instead of
+// stretching it across all of them (gaps between monitors stay black).
+static Pixmap load_wallpaper_to_pixmap(Display *dpy, int screen_num, const char *path,
+                                       bool tile, bool per_output) {
     if (!path || strlen(path) == 0) return None;
     Imlib_Image img = imlib_load_image(path);
     if (!img) {
@@ -26,8 +29,20 @@ static Pixmap load_wallpaper_to_pixmap(Display *dpy, int screen_num, const char
 
     Pixmap pixmap = XCreatePixmap(dpy, RootWindow(dpy, screen_num), screen_width, screen_height, DefaultDepth(dpy, screen_num));
 
+    XRectangle outputs[MAX_OUTPUTS];
+    int output_count = per_output ? itn_outputs_get_rects(outputs, MAX_OUTPUTS) : 0;
+
     imlib_context_set_drawable(pixmap);
-    if (!tile) {
+    if (!tile && output_count > 1) {
+        GC gc = XCreateGC(dpy, pixmap, 0, NULL);
+        XSetForeground(dpy, gc, BlackPixel(dpy, screen_num));
+        XFillRectangle(dpy, pixmap, gc, 0, 0, screen_width, screen_height);
+        XFreeGC(dpy, gc);
+        for (int i = 0; i < output_count; i++) {
+            imlib_render_image_on_drawable_at_size(outputs[i].x, outputs[i].y,
+                                                   outputs[i].width, outputs[i].height);
+        }
+    } else if (!tile) {
         imlib_render_image_on_drawable_at_size(0, 0, screen_width, screen_height);
     } else {
         for (int y = 0; y < screen_height; y += img_height) {
@@ -72,7 +87,7 @@ void render_load_wallpapers(void) {
 
     // Load desktop background if configured
     if (cfg->desktop_background[0]) {
-        ctx->desk_img = load_wallpaper_to_pixmap(dpy, scr, cfg->desktop_background, cfg->desktop_tiling);
+        ctx->desk_img = load_wallpaper_to_pixmap(dpy, scr, cfg->desktop_background, cfg->desktop_tiling, true);
         // Create cached Picture for desktop wallpaper
         if (ctx->desk_img != None) {
             Visual *visual = DefaultVisual(dpy, DefaultScreen(dpy));
@@ -84,7 +99,8 @@ void render_load_wallpapers(void) {
     }
     // Load window background if configured
     if (cfg->window_background[0]) {
-        ctx->wind_img = load_wallpaper_to_pixmap(dpy, scr, cfg->window_background, cfg->window_tiling);
+        // Window background is sampled under windows, which can span monitors
+        ctx->wind_img = load_wallpaper_to_pixmap(dpy, scr, cfg->window_background, cfg->window_tiling, false);
         // Create cached Picture for window wallpaper
         if (ctx->wind_img != None) {
             Visual *visual = DefaultVisual(dpy, DefaultScreen(dpy));
@@ -20,6 +20,40 @@ static bool ends_with(const char *s, const char *suffix) {
     return l >= m && strcmp(s + l - m, suffix) == 0;
 }
 
+// One directory entry that gets an icon (gathered before creating icons)
+typedef struct {
+    char *full_path;            // File the icon stands for
+    char *icon_path;            // .info (sidecar or deficon) to decode
+    char *name;                 // Label
+    int type;
+} DirIconEntry;
+
+// Remember an entry - false only if out of memory
+static bool add_dir_entry(DirIconEntry **entries, int *count, int *capacity,
+                          const char *full_path, const char *icon_path,
+                          const char *name, int type) {
+    if (*count == *capacity) {
+        int new_capacity = *capacity ? *capacity * 2 : 64;
+        DirIconEntry *grown = realloc(*entries, new_capacity * sizeof(DirIconEntry));
+        if (!grown) return false;
+        *entries = grown;
+        *capacity = new_capacity;
+    }
+    DirIconEntry *e = &(*entries)[*count];
+    e->full_path = strdup(full_path);
+    e->icon_path = strdup(icon_path);
+    e->name = strdup(name);
+    e->type = type;
+    if (!e->full_path || !e->icon_path || !e->name) {
+        free(e->full_path);
+        free(e->icon_path);
+        free(e->name);
+        return false;
+    }
+    (*count)++;
+    return true;
+}
+
 // ============================================================================
 // Canvas Refresh from Directory
 // ============================================================================
@@ -48,6 +82,11 @@ void refresh_canvas_from_directory(Canvas *canvas, const char *dirpath) {
     
     // Prime desktop icons (System, Home) are handled by diskdrives.c
     
+    // First pass: collect entries, so their .info files can be decoded on
+    // the worker pool (icon_workers.c) while the icons are created in order
+    DirIconEntry *entries = NULL;
+    int entry_count = 0, entry_capacity = 0;
+
     DIR *dirp = opendir(dir);
     if (dirp) {
         struct dirent *entry;
@@ -86,8 +125,10 @@ void refresh_canvas_from_directory(Canvas *canvas, const char *dirpath) {
                 if (stat(base_path, &st) != 0) {
                     // Orphan .info - create at 0,0
                     // Use full_path (the .info file itself), not info_path (which has .info appended again)
-                    wb_icons_create_with_icon_path(full_path, canvas, 0, 0,
-                                              full_path, entry->d_name, TYPE_FILE);
+                    if (!add_dir_entry(&entries, &entry_count, &entry_capacity,
+                                       full_path, full_path, entry->d_name, TYPE_FILE)) {
+                        log_error("[ERROR] Out of memory listing %s - icon will not appear", full_path);
+                    }
                 }
                 continue;
             }
@@ -102,13 +143,35 @@ void refresh_canvas_from_directory(Canvas *canvas, const char *dirpath) {
             const char *icon_path = has_sidecar ? info_path : 
                                     wb_deficons_get_for_file(entry->d_name, type == TYPE_DRAWER);
             
-            if (icon_path) {
-                wb_icons_create_with_icon_path(icon_path, canvas, 0, 0,
-                                         full_path, entry->d_name, type);
+            if (icon_path && !add_dir_entry(&entries, &entry_count, &entry_capacity,
+                                            full_path, icon_path, entry->d_name, type)) {
+                log_error("[ERROR] Out of memory listing %s - icon will not appear", full_path);
             }
         }
         closedir(dirp);
     }
+
+    // Second pass: decode ahead, create icons in directory order
+    if (entry_count > 0) {
+        const char **icon_paths = malloc(entry_count * sizeof(const char *));
+        if (icon_paths) {
+            for (int i = 0; i < entry_count; i++) icon_paths[i] = entries[i].icon_path;
+            icon_prefetch(icon_paths, entry_count);
+            free(icon_paths);
+        }
+
+        for (int i = 0; i < entry_count; i++) {
+            wb_icons_create_with_icon_path(entries[i].icon_path, canvas, 0, 0,
+                                           entries[i].full_path, entries[i].name, entries[i].type);
+        }
+        icon_prefetch_finish();
+    }
+    for (int i = 0; i < entry_count; i++) {
+        free(entries[i].full_path);
+        free(entries[i].icon_path);
+        free(entries[i].name);
+    }
+    free(entries);
     
     // Re-enable icon rendering
     canvas->scanning = false;
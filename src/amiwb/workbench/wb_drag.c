@@ -908,7 +908,12 @@ static void perform_cross_canvas_drop(Canvas *target) {
         if (drag_source_canvas) {
             refresh_canvas(drag_source_canvas);
         }
-        redraw_canvas(target);
+        // List view re-laid out every row; icon view only gained the new icon
+        if (target->type == WINDOW && target->view_mode == VIEW_NAMES) {
+            redraw_canvas(target);
+        } else {
+            redraw_canvas_icons(target, true);
+        }
     } else {
         // Move failed - restore icon
         restore_dragged_icon_to_origin();
@@ -6,8 +6,8 @@
 #include "../config.h"
 #include "../render/rnd_public.h"
 #include "../intuition/itn_public.h"
-#include "../intuition/itn_internal.h"  // For DAMAGE_RECT, SCHEDULE_FRAME macros
 #include <X11/Xlib.h>
+#include <stdlib.h>
 
 
 // ============================================================================
@@ -101,7 +101,7 @@ static void multiselect_update_live_selection(Canvas *canvas, int x1, int y1, in
             int text_left_pad = 6;
             icon_x = base_x + icon->x + text_left_pad - sx;
             icon_y = base_y + icon->y - sy;
-            icon_w = get_text_width(icon->label ? icon->label : "");
+            icon_w = icon_label_width(icon);
             icon_h = row_h;
         } else {
             // Icon view - icon + label area (pattern from find_icon:66-73)
@@ -146,12 +146,9 @@ static void multiselect_update(Canvas *canvas, int x, int y) {
     // Update live icon selection based on current rectangle
     multiselect_update_live_selection(canvas, multiselect_start_x, multiselect_start_y, x, y);
 
-    // Refresh canvas to show updated rectangle and icon selection
-    redraw_canvas(canvas);
-
-    // Damage and schedule frame
-    DAMAGE_CANVAS(canvas);
-    SCHEDULE_FRAME();
+    // Re-render only icons whose selection flipped; the rectangle itself is
+    // drawn on the window (XDamage reports just the touched areas)
+    redraw_canvas_icons(canvas, false);
 }
 
 // Complete selection and cleanup
@@ -165,9 +162,9 @@ static void multiselect_end(void) {
     multiselect_pending = false;
     multiselect_target_canvas = NULL;
 
-    // Refresh canvas to remove rectangle
+    // Remove rectangle (restored from the canvas buffer)
     if (target) {
-        redraw_canvas(target);
+        redraw_canvas_icons(target, false);
     }
 }
 
@@ -184,6 +181,26 @@ void wb_draw_multiselection_rect(Canvas *canvas, Drawable d, Visual *visual) {
                            multiselect_current_x, multiselect_current_y);
 }
 
+// Area the selection rectangle covers on this canvas (false if none is drawn)
+bool wb_get_multiselection_rect(Canvas *canvas, XRectangle *out) {
+    if (!wb_is_multiselecting(canvas) || !out) return false;
+
+    int x1 = min(multiselect_start_x, multiselect_current_x);
+    int y1 = min(multiselect_start_y, multiselect_current_y);
+    int w = abs(multiselect_current_x - multiselect_start_x);
+    int h = abs(multiselect_current_y - multiselect_start_y);
+    if (w < 2 || h < 2) return false;  // rnd_draw_selection_rect skips these too
+
+    *out = (XRectangle){x1, y1, w, h};
+    return true;
+}
+
+// Is a selection rectangle being dragged on this canvas?
+// (scrolling then redraws fully - the rectangle doesn't scroll with content)
+bool wb_is_multiselecting(Canvas *canvas) {
+    return canvas && multiselect_active && canvas == multiselect_target_canvas;
+}
+
 // ============================================================================
 // Event Handlers
 // ============================================================================
@@ -281,7 +298,8 @@ void workbench_handle_button_press(XButtonEvent *event) {
         multiselect_target_canvas = canvas;
     }
 
-    redraw_canvas(canvas);
+    // Selection changes only
+    redraw_canvas_icons(canvas, false);
 }
 
 void workbench_handle_motion_notify(XMotionEvent *event) {
@@ -42,6 +42,7 @@ FileIcon *wb_icons_create_with_icon_path(const char *icon_path, Canvas *canvas,
                 log_error("[ERROR] strdup failed for icon label - keeping original label");
                 // Graceful degradation: keep old label rather than crashing
             }
+            icon_update_label_width(icon);
         }
         icon->type = type;
     }
@@ -268,6 +269,7 @@ FileIcon* create_iconified_icon(Canvas *c) {
     ni->iconified_canvas = c;
     if (ni->label) free(ni->label);
     ni->label = label;
+    icon_update_label_width(ni);
 
     return ni;
 }
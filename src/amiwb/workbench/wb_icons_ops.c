@@ -59,7 +59,7 @@ FileIcon *find_icon(Window win, int x, int y) {
             int row_h = 18 + 6;
             int text_left_pad = 6;
             int text_x = base_x + ic->x + text_left_pad;
-            int text_w = get_text_width(ic->label ? ic->label : "");
+            int text_w = icon_label_width(ic);
             if (x >= text_x && x <= text_x + text_w && y >= ry && y <= ry + row_h) {
                 return ic;
             }
@@ -110,7 +110,7 @@ void wb_layout_compute_bounds(Canvas *canvas) {
         int max_y = 0;
         for (int i = 0; i < icon_count; i++) {
             if (icon_array[i]->display_window == canvas->win) {
-                int lw = get_text_width(icon_array[i]->label ? icon_array[i]->label : "");
+                int lw = icon_label_width(icon_array[i]);
                 if (lw > max_text_w) max_text_w = lw;
                 max_y = max(max_y, icon_array[i]->y + 24);
             }
@@ -128,7 +128,7 @@ void wb_layout_compute_bounds(Canvas *canvas) {
                 FileIcon *icon = icon_array[i];
 
                 // Labels are centered below icons - can extend beyond icon edges
-                int label_w = get_text_width(icon->label ? icon->label : "");
+                int label_w = icon_label_width(icon);
                 int icon_center = icon->x + icon->width / 2;
                 int label_right = icon_center + label_w / 2;  // Right edge of centered label
                 int icon_right = icon->x + icon->width;       // Right edge of icon graphic
@@ -242,7 +242,7 @@ void icon_cleanup(Canvas *canvas) {
             for (int row = 0; row < num_rows; row++) {
                 int i2 = col * num_rows + row;
                 if (i2 >= count) break;
-                int label_w = get_text_width(list[i2]->label);
+                int label_w = icon_label_width(list[i2]);
                 if (label_w > max_w_in_col) max_w_in_col = label_w;
             }
             col_widths[col] = max(min_cell_w, min(max_w_in_col + padding, max_allowed_w + padding));
@@ -315,7 +315,7 @@ void wb_layout_apply_view(Canvas *canvas) {
         int icon_count = wb_icons_array_count();
         for (int i = 0; i < icon_count; i++) {
             if (icon_array[i]->display_window == canvas->win) {
-                int lw = get_text_width(icon_array[i]->label ? icon_array[i]->label : "");
+                int lw = icon_label_width(icon_array[i]);
                 if (lw > max_text_w) max_text_w = lw;
             }
         }
@@ -332,7 +332,7 @@ void wb_progress_monitor_render(Canvas *canvas) {
 
     // Truncate with "..." if too long
     XGlyphInfo text_ext;
-    XftTextExtentsUtf8(dpy, font, (FcChar8*)display_text, strlen(display_text), &text_ext);
+    font_manager_text_extents(font, display_text, &text_ext);
     int max_width = content_w - 40;  // Leave margin
 
     if (text_ext.xOff > max_width) {
@@ -344,7 +344,7 @@ void wb_progress_monitor_render(Canvas *canvas) {
             display_text[len - 3] = '.';
             display_text[len - 4] = '.';
             len -= 4;
-            XftTextExtentsUtf8(dpy, font, (FcChar8*)display_text, strlen(display_text), &text_ext);
+            font_manager_text_extents(font, display_text, &text_ext);
             if (text_ext.xOff <= max_width) break;
         }
     }
@@ -424,7 +424,7 @@ void wb_progress_monitor_render(Canvas *canvas) {
 
     // Draw "Abort" text
     XGlyphInfo abort_ext;
-    XftTextExtentsUtf8(dpy, font, (FcChar8*)"Abort", 5, &abort_ext);
+    font_manager_text_extents(font, "Abort", &abort_ext);
     int abort_text_x = button_x + (BUTTON_WIDTH - abort_ext.xOff) / 2;
     int abort_text_y = button_y + (BUTTON_HEIGHT + font->ascent) / 2 - 2;
     XftDrawStringUtf8(canvas->xft_draw, &xft_text, font, abort_text_x, abort_text_y,
@@ -135,5 +135,7 @@ void open_directory(FileIcon *icon, Canvas *current_canvas);
 
 // Multiselection rectangle rendering (from wb_events.c)
 void wb_draw_multiselection_rect(Canvas *canvas, Drawable d, Visual *visual);
+bool wb_is_multiselecting(Canvas *canvas);
+bool wb_get_multiselection_rect(Canvas *canvas, XRectangle *out);
 
 #endif // WB_PUBLIC_H
@@ -0,0 +1,91 @@
+#!/bin/sh
+# File: bench-compositor.sh
+# Headless compositor benchmark: amiwb on Xvfb driven by bench_client
+#
+# Runs amiwb with a throwaway HOME (default amiwbrc, log in
+# $HOME/Sources/amiwb/amiwb.log), lets bench_client generate a fixed workload,
+# and asks amiwb for a [METRICS] snapshot with SIGUSR1 before and after.
+# The first snapshot only resets the counters, the second covers the run.
+#
+# Needs Xvfb and the installed resources (make install) - amiwb loads icons,
+# fonts and patterns from /usr/local/share/amiwb.
+#
+# Environment:
+#   AMIWB          amiwb binary          (default ../../amiwb)
+#   BENCH_DISPLAY  Xvfb display          (default :99)
+#   BENCH_SCREEN   Xvfb screen geometry  (default 1920x1080x24)
+#   BENCH_ARGS     bench_client options  (default "-n 8 -w 400 -h 300 -d 24 -t 10")
+#   BENCH_MIN_FPS  fail (exit 1) if compositor FPS ends up below this
+
+AMIWB=${AMIWB:-../../amiwb}
+BENCH_DISPLAY=${BENCH_DISPLAY:-:99}
+BENCH_SCREEN=${BENCH_SCREEN:-1920x1080x24}
+BENCH_ARGS=${BENCH_ARGS:--n 8 -w 400 -h 300 -d 24 -t 10}
+CLIENT=./bench_client
+
+if ! command -v Xvfb >/dev/null 2>&1; then
+    echo "[BENCH] Xvfb not found" >&2
+    exit 1
+fi
+if [ ! -x "$AMIWB" ] || [ ! -x "$CLIENT" ]; then
+    echo "[BENCH] Build amiwb and bench_client first" >&2
+    exit 1
+fi
+
+BENCH_HOME=$(mktemp -d /tmp/amiwb-bench.XXXXXX)
+LOG="$BENCH_HOME/Sources/amiwb/amiwb.log"
+mkdir -p "$BENCH_HOME/Sources/amiwb"
+
+XVFB_PID=
+AMIWB_PID=
+cleanup() {
+    [ -n "$AMIWB_PID" ] && kill "$AMIWB_PID" 2>/dev/null
+    [ -n "$XVFB_PID" ] && kill "$XVFB_PID" 2>/dev/null
+    wait 2>/dev/null
+    rm -rf "$BENCH_HOME"
+}
+trap cleanup EXIT INT TERM
+
+Xvfb "$BENCH_DISPLAY" -screen 0 "$BENCH_SCREEN" -nolisten tcp +extension COMPOSITE \
+    >/dev/null 2>&1 &
+XVFB_PID=$!
+sleep 1
+
+DISPLAY=$BENCH_DISPLAY HOME=$BENCH_HOME "$AMIWB" >/dev/null 2>&1 &
+AMIWB_PID=$!
+sleep 2
+if ! kill -0 "$AMIWB_PID" 2>/dev/null; then
+    echo "[BENCH] amiwb exited during startup - see log below" >&2
+    cat "$LOG" >&2
+    exit 1
+fi
+
+# Reset counters (startup frames are not part of the run)
+kill -USR1 "$AMIWB_PID"
+sleep 1
+: > "$LOG"
+
+# shellcheck disable=SC2086
+DISPLAY=$BENCH_DISPLAY "$CLIENT" $BENCH_ARGS
+CLIENT_STATUS=$?
+
+kill -USR1 "$AMIWB_PID"
+sleep 1
+
+echo "[BENCH] ---- amiwb compositor ----"
+sed -n 's/^\[[0-9:]*\] \[METRICS\] */  /p' "$LOG" | grep -v '^  Performance snapshot requested' | grep -v '^  =*$'
+
+if [ "$CLIENT_STATUS" -ne 0 ]; then
+    echo "[BENCH] bench_client failed ($CLIENT_STATUS)" >&2
+    exit 1
+fi
+
+if [ -n "$BENCH_MIN_FPS" ]; then
+    FPS=$(sed -n 's/.*Actual FPS: \([0-9.]*\).*/\1/p' "$LOG" | tail -n 1)
+    if [ -z "$FPS" ] || awk "BEGIN { exit !($FPS < $BENCH_MIN_FPS) }"; then
+        echo "[BENCH] FAIL: ${FPS:-no} fps, minimum $BENCH_MIN_FPS" >&2
+        exit 1
+    fi
+    echo "[BENCH] PASS: $FPS fps (minimum $BENCH_MIN_FPS)"
+fi
+exit 0
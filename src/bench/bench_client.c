@@ -0,0 +1,235 @@
+// File: bench_client.c
+// Synthetic client driver for the compositor benchmark (make bench-compositor)
+// Maps N toplevel windows, then for a fixed time keeps the compositor busy:
+// damage storms (every window repainted each iteration), moves and raises,
+// and override-redirect "tooltips" popping in and out. Deterministic - the
+// same options always produce the same request stream.
+// Prints its own side of the run (iterations, round-trips, latency) as
+// "[BENCH] key: value" lines for bench-compositor.sh to collect.
+
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+#define MAX_WINDOWS   256
+#define MAX_TOOLTIPS  4
+#define TOOLTIP_W     160
+#define TOOLTIP_H     24
+
+// ============================================================================
+// Options
+// ============================================================================
+
+static struct {
+    int windows;        // -n
+    int width;          // -w
+    int height;         // -h
+    int depth;          // -d (24 or 32)
+    int seconds;        // -t
+    int move_every;     // -m  iterations between move/raise steps (0 = never)
+    int tooltip_every;  // -p  iterations between tooltip toggles (0 = never)
+} opt = { 8, 400, 300, 24, 10, 2, 5 };
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "usage: %s [-n windows] [-w width] [-h height] [-d 24|32]\n"
+            "          [-t seconds] [-m move_every] [-p tooltip_every]\n", prog);
+}
+
+static bool parse_options(int argc, char *argv[]) {
+    int c;
+    while ((c = getopt(argc, argv, "n:w:h:d:t:m:p:")) != -1) {
+        switch (c) {
+            case 'n': opt.windows = atoi(optarg); break;
+            case 'w': opt.width = atoi(optarg); break;
+            case 'h': opt.height = atoi(optarg); break;
+            case 'd': opt.depth = atoi(optarg); break;
+            case 't': opt.seconds = atoi(optarg); break;
+            case 'm': opt.move_every = atoi(optarg); break;
+            case 'p': opt.tooltip_every = atoi(optarg); break;
+            default: return false;
+        }
+    }
+    if (opt.windows < 1 || opt.windows > MAX_WINDOWS) return false;
+    if (opt.width < 1 || opt.height < 1 || opt.seconds < 1) return false;
+    if (opt.depth != 24 && opt.depth != 32) return false;
+    return true;
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static inline int max_int(int a, int b) { return a > b ? a : b; }
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// Create a window of the requested depth (32 needs an ARGB visual + colormap)
+static Window create_window(Display *dpy, Visual *visual, int depth, Colormap cmap,
+                            int x, int y, int w, int h, bool override) {
+    XSetWindowAttributes attrs;
+    memset(&attrs, 0, sizeof(attrs));
+    attrs.colormap = cmap;
+    attrs.border_pixel = 0;
+    attrs.background_pixel = 0;
+    attrs.override_redirect = override ? True : False;
+    unsigned long mask = CWColormap | CWBorderPixel | CWBackPixel | CWOverrideRedirect;
+
+    return XCreateWindow(dpy, DefaultRootWindow(dpy), x, y, w, h, 0, depth,
+                         InputOutput, visual, mask, &attrs);
+}
+
+// Full XSync = one round-trip; returns its latency in ms
+static double round_trip(Display *dpy) {
+    double start = now_ms();
+    XSync(dpy, False);
+    return now_ms() - start;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char *argv[]) {
+    if (!parse_options(argc, argv)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    Display *dpy = XOpenDisplay(NULL);
+    if (!dpy) {
+        fprintf(stderr, "[BENCH] Cannot open display\n");
+        return 1;
+    }
+
+    int screen = DefaultScreen(dpy);
+    int sw = DisplayWidth(dpy, screen);
+    int sh = DisplayHeight(dpy, screen);
+
+    Visual *visual = DefaultVisual(dpy, screen);
+    Colormap cmap = DefaultColormap(dpy, screen);
+    if (opt.depth == 32) {
+        XVisualInfo vinfo;
+        if (!XMatchVisualInfo(dpy, screen, 32, TrueColor, &vinfo)) {
+            fprintf(stderr, "[BENCH] No 32-bit TrueColor visual\n");
+            XCloseDisplay(dpy);
+            return 1;
+        }
+        visual = vinfo.visual;
+        cmap = XCreateColormap(dpy, DefaultRootWindow(dpy), visual, AllocNone);
+    }
+
+    // Toplevels, cascaded so they overlap (occlusion is part of the workload)
+    Window wins[MAX_WINDOWS];
+    GC gcs[MAX_WINDOWS];
+    int wx[MAX_WINDOWS], wy[MAX_WINDOWS];
+    for (int i = 0; i < opt.windows; i++) {
+        wx[i] = (i * 37) % max_int(1, sw - opt.width);
+        wy[i] = 30 + (i * 23) % max_int(1, sh - opt.height - 30);
+        wins[i] = create_window(dpy, visual, opt.depth, cmap,
+                                wx[i], wy[i], opt.width, opt.height, false);
+        XStoreName(dpy, wins[i], "bench");
+        XSelectInput(dpy, wins[i], StructureNotifyMask);
+        gcs[i] = XCreateGC(dpy, wins[i], 0, NULL);
+        XMapWindow(dpy, wins[i]);
+    }
+
+    Window tips[MAX_TOOLTIPS];
+    bool tip_mapped[MAX_TOOLTIPS] = {false};
+    for (int t = 0; t < MAX_TOOLTIPS; t++) {
+        tips[t] = create_window(dpy, visual, opt.depth, cmap,
+                                0, 0, TOOLTIP_W, TOOLTIP_H, true);
+    }
+
+    // Let the window manager frame and map everything before timing starts
+    XSync(dpy, False);
+    sleep(1);
+    XSync(dpy, False);
+
+    uint64_t iterations = 0, round_trips = 0, moves = 0, raises = 0, tooltips = 0;
+    uint64_t pixels = 0;
+    double rt_total = 0.0, rt_worst = 0.0;
+
+    double start = now_ms();
+    double end = start + opt.seconds * 1000.0;
+    while (now_ms() < end) {
+        // Damage storm: repaint every window in a colour that changes each pass
+        for (int i = 0; i < opt.windows; i++) {
+            unsigned long pixel = 0xff000000UL |
+                                  ((iterations * 2654435761UL + i * 40503UL) & 0xffffffUL);
+            XSetForeground(dpy, gcs[i], pixel);
+            XFillRectangle(dpy, wins[i], gcs[i], 0, 0, opt.width, opt.height);
+            pixels += (uint64_t)opt.width * opt.height;
+        }
+
+        // Move one window a little and raise it (window manager sees the requests)
+        if (opt.move_every > 0 && iterations % opt.move_every == 0) {
+            int i = (int)((iterations / opt.move_every) % opt.windows);
+            wx[i] = (wx[i] + 17) % max_int(1, sw - opt.width);
+            wy[i] = 30 + (wy[i] + 11) % max_int(1, sh - opt.height - 30);
+            XMoveWindow(dpy, wins[i], wx[i], wy[i]);
+            XRaiseWindow(dpy, wins[i]);
+            moves++;
+            raises++;
+        }
+
+        // Tooltips: override-redirect windows mapped/unmapped over everything
+        if (opt.tooltip_every > 0 && iterations % opt.tooltip_every == 0) {
+            int t = (int)((iterations / opt.tooltip_every) % MAX_TOOLTIPS);
+            if (tip_mapped[t]) {
+                XUnmapWindow(dpy, tips[t]);
+            } else {
+                int tx = (int)((iterations * 53) % max_int(1, sw - TOOLTIP_W));
+                int ty = (int)((iterations * 29) % max_int(1, sh - TOOLTIP_H));
+                XMoveWindow(dpy, tips[t], tx, ty);
+                XMapRaised(dpy, tips[t]);
+                tooltips++;
+            }
+            tip_mapped[t] = !tip_mapped[t];
+        }
+
+        // One round-trip per iteration keeps us from queueing unbounded work
+        double rt = round_trip(dpy);
+        rt_total += rt;
+        if (rt > rt_worst) rt_worst = rt;
+        round_trips++;
+
+        // Drain ConfigureNotify etc. - we don't act on them
+        while (XPending(dpy)) {
+            XEvent ev;
+            XNextEvent(dpy, &ev);
+        }
+        iterations++;
+    }
+    double elapsed = (now_ms() - start) / 1000.0;
+
+    printf("[BENCH] Windows: %d x %dx%d depth %d\n", opt.windows, opt.width, opt.height, opt.depth);
+    printf("[BENCH] Duration: %.2f s\n", elapsed);
+    printf("[BENCH] Iterations: %lu (%.1f/s)\n", iterations, iterations / elapsed);
+    printf("[BENCH] Client pixels filled: %.1f MP\n", pixels / 1000000.0);
+    printf("[BENCH] Moves: %lu, raises: %lu, tooltips shown: %lu\n", moves, raises, tooltips);
+    printf("[BENCH] Client round-trips: %lu, avg %.3f ms, worst %.3f ms\n",
+           round_trips, round_trips ? rt_total / round_trips : 0.0, rt_worst);
+
+    for (int t = 0; t < MAX_TOOLTIPS; t++) XDestroyWindow(dpy, tips[t]);
+    for (int i = 0; i < opt.windows; i++) {
+        XFreeGC(dpy, gcs[i]);
+        XDestroyWindow(dpy, wins[i]);
+    }
+    XCloseDisplay(dpy);
+    return 0;
+}
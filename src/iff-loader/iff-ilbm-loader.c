@@ -98,32 +98,51 @@ static int decompress_byterun1(uint8_t *dest, const uint8_t *src, int dest_size,
     return dest_pos;
 }
 
+// Plane byte -> 8 pixel lanes of 0/1, leftmost pixel first in memory
+// (same table-driven conversion as amiwb's icon_render.c)
+static uint64_t plane_spread[256];
+static int plane_spread_ready = 0;
+
+static void init_plane_spread(void) {
+    for (int b = 0; b < 256; b++) {
+        uint8_t lanes[8];
+        for (int i = 0; i < 8; i++) lanes[i] = (b >> (7 - i)) & 1;
+        memcpy(&plane_spread[b], lanes, sizeof(lanes));
+    }
+    plane_spread_ready = 1;
+}
+
 // Convert planar bitmap to chunky RGB
 static void planar_to_chunky(uint8_t *rgb_data, const uint8_t *planar_data,
                               int width, int height, int num_planes,
                               uint8_t cmap[][3], int row_stride) {
     int row_bytes = ((width + 15) >> 4) << 1;  // Round up to word boundary
     int plane_size = row_bytes * height;
+    // Color indices are 8 bits - planes past the 8th never contributed
+    int planes = num_planes < 8 ? num_planes : 8;
+
+    if (!plane_spread_ready) init_plane_spread();
 
     for (int y = 0; y < height; y++) {
         uint8_t *out_row = rgb_data + y * row_stride;
+        const uint8_t *row = planar_data + y * row_bytes;
 
-        for (int x = 0; x < width; x++) {
-            int byte_offset = x >> 3;
-            int bit_offset = 7 - (x & 7);
-            uint8_t color_index = 0;
-
-            // Combine bits from each plane
-            for (int plane = 0; plane < num_planes; plane++) {
-                const uint8_t *plane_ptr = planar_data + plane * plane_size;
-                uint8_t bit = (plane_ptr[y * row_bytes + byte_offset] >> bit_offset) & 1;
-                color_index |= (bit << plane);
+        for (int col = 0; col * 8 < width; col++) {
+            // 8 color indices at once: OR each plane's spread lanes in at its bit
+            uint64_t lanes = 0;
+            for (int plane = 0; plane < planes; plane++) {
+                lanes |= plane_spread[row[plane * plane_size + col]] << plane;
+            }
+            uint8_t indices[8];
+            memcpy(indices, &lanes, sizeof(indices));
+
+            int count = width - col * 8 < 8 ? width - col * 8 : 8;
+            for (int i = 0; i < count; i++) {
+                // Write RGB pixel
+                *out_row++ = cmap[indices[i]][0];
+                *out_row++ = cmap[indices[i]][1];
+                *out_row++ = cmap[indices[i]][2];
             }
-
-            // Write RGB pixel
-            *out_row++ = cmap[color_index][0];
-            *out_row++ = cmap[color_index][1];
-            *out_row++ = cmap[color_index][2];
         }
     }
 }